@@ -28,6 +28,7 @@
 
 #include "sx_node.hpp"
 #include "serializing_stream.hpp"
+#include "global_options.hpp"
 
 /// \cond INTERNAL
 namespace casadi {
@@ -41,7 +42,15 @@ class BinarySX : public SXNode {
 
     /** \brief  Constructor is private, use "create" below */
     BinarySX(unsigned char op, const SXElem& dep0, const SXElem& dep1) :
-        op_(op), dep0_(dep0), dep1_(dep1) {}
+        op_(op), cached_(false), dep0_(dep0), dep1_(dep1) {}
+
+    /** \brief  Key in the hash-consing table, arguments of commutative operations sorted */
+    static SXNodeKey cache_key(unsigned char op, const SXNode* dep0, const SXNode* dep1) {
+      if (operation_checker<CommChecker>(op) && std::less<const SXNode*>()(dep1, dep0)) {
+        std::swap(dep0, dep1);
+      }
+      return SXNodeKey{op, dep0, dep1};
+    }
 
   public:
 
@@ -54,6 +63,18 @@ class BinarySX : public SXNode {
         double ret_val;
         casadi_math<double>::fun(op, dep0_val, dep1_val, ret_val);
         return ret_val;
+      } else if (GlobalOptions::hash_consing) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+        std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+        // Reuse an identical node if there is one, unless being deleted by another thread
+        SXNodeKey key = cache_key(op, dep0.get(), dep1.get());
+        SXNode* c = cached_nodes_.find(key);
+        if (c!=nullptr && c->count!=0) return SXElem::create(c);
+        BinarySX* n = new BinarySX(op, dep0, dep1);
+        n->cached_ = true;
+        cached_nodes_.set(key, n);
+        return SXElem::create(n);
       } else {
         // Expression containing free variables
         return SXElem::create(new BinarySX(op, dep0, dep1));
@@ -65,10 +86,23 @@ class BinarySX : public SXNode {
     can cause stack overflow due to recursive calling.
     */
     ~BinarySX() override {
+      uncache();
       safe_delete(dep0_.assignNoDelete(casadi_limits<SXElem>::nan));
       safe_delete(dep1_.assignNoDelete(casadi_limits<SXElem>::nan));
     }
 
+    /** \brief Remove from the hash-consing table */
+    void uncache() override {
+      if (cached_) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+        std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+        // The entry may already refer to a replacement
+        cached_nodes_.erase(cache_key(op_, dep0_.get(), dep1_.get()), this);
+        cached_ = false;
+      }
+    }
+
     // Class name
     std::string class_name() const override {return "BinarySX";}
 
@@ -107,6 +141,9 @@ class BinarySX : public SXNode {
     /** \brief  The binary operation as an 1 byte integer (allows 256 values) */
     unsigned char op_;
 
+    /** \brief  Is the node in the hash-consing table */
+    bool cached_;
+
     /** \brief  The dependencies of the node */
     SXElem dep0_, dep1_;
 
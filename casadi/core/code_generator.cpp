@@ -927,6 +927,13 @@ namespace casadi {
       add_auxiliary(AUX_CLEAR, {"casadi_int"});
       this->auxiliaries << sanitize_source(casadi_interpn_str, inst);
       break;
+    case AUX_INTERPN_BATCH:
+      add_auxiliary(AUX_LOW_HINT);
+      add_auxiliary(AUX_FLIP, {});
+      add_auxiliary(AUX_CLEAR);
+      add_auxiliary(AUX_CLEAR, {"casadi_int"});
+      this->auxiliaries << sanitize_source(casadi_interpn_batch_str, inst);
+      break;
     case AUX_INTERPN_GRAD:
       add_auxiliary(AUX_INTERPN);
       this->auxiliaries << sanitize_source(casadi_interpn_grad_str, inst);
@@ -949,6 +956,10 @@ namespace casadi {
     case AUX_LOW:
       this->auxiliaries << sanitize_source(casadi_low_str, inst);
       break;
+    case AUX_LOW_HINT:
+      add_auxiliary(AUX_LOW);
+      this->auxiliaries << sanitize_source(casadi_low_hint_str, inst);
+      break;
     case AUX_INTERPN_WEIGHTS:
       add_auxiliary(AUX_LOW);
       this->auxiliaries << sanitize_source(casadi_interpn_weights_str, inst);
@@ -1059,6 +1070,24 @@ namespace casadi {
 
       this->auxiliaries << sanitize_source(casadi_qp_str, inst);
       break;
+    case AUX_IPQP:
+      add_auxiliary(AUX_COPY);
+      add_auxiliary(AUX_LDL);
+      add_auxiliary(AUX_MAX);
+      add_auxiliary(AUX_FMIN);
+      add_auxiliary(AUX_FMAX);
+      add_auxiliary(AUX_TRANS);
+      add_auxiliary(AUX_AXPY);
+      add_auxiliary(AUX_DOT);
+      add_auxiliary(AUX_MV);
+      add_auxiliary(AUX_BILIN);
+      add_auxiliary(AUX_INF);
+      add_auxiliary(AUX_CLEAR);
+      add_include("stdio.h");
+      add_include("math.h");
+
+      this->auxiliaries << sanitize_source(casadi_ipqp_str, inst);
+      break;
     case AUX_NLP:
       this->auxiliaries << sanitize_source(casadi_nlp_str, inst);
       break;
@@ -1404,6 +1433,19 @@ namespace casadi {
     return s.str();
   }
 
+  string CodeGenerator::interpn_batch(const std::string& res, casadi_int ndim,
+                                      const string& grid, const string& offset,
+                                      const string& values, const string& x,
+                                      const string& lookup_mode, casadi_int m, casadi_int n,
+                                      const string& iw, const string& w) {
+    add_auxiliary(AUX_INTERPN_BATCH);
+    stringstream s;
+    s << "casadi_interpn_batch(" << res << ", " << ndim << ", " << grid << ", "  << offset << ", "
+      << values << ", " << x << ", " << lookup_mode << ", " << m << ", " << n << ", "
+      << iw << ", " << w << ");";
+    return s.str();
+  }
+
   string CodeGenerator::interpn_grad(const string& grad,
                                    casadi_int ndim, const string& grid, const string& offset,
                                    const string& values, const string& x,
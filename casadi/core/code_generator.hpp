@@ -212,6 +212,13 @@ namespace casadi {
                         const std::string& lookup_mode, casadi_int m,
                         const std::string& iw, const std::string& w);
 
+    /** \brief Multilinear interpolation of n points */
+    std::string interpn_batch(const std::string& res, casadi_int ndim, const std::string& grid,
+                              const std::string& offset,
+                              const std::string& values, const std::string& x,
+                              const std::string& lookup_mode, casadi_int m, casadi_int n,
+                              const std::string& iw, const std::string& w);
+
     /** \brief Multilinear interpolation - calculate gradient */
     std::string interpn_grad(const std::string& grad,
       casadi_int ndim, const std::string& grid,
@@ -341,16 +348,19 @@ namespace casadi {
       AUX_TO_MEX,
       AUX_FROM_MEX,
       AUX_INTERPN,
+      AUX_INTERPN_BATCH,
       AUX_INTERPN_GRAD,
       AUX_FLIP,
       AUX_INTERPN_WEIGHTS,
       AUX_LOW,
+      AUX_LOW_HINT,
       AUX_INTERPN_INTERPOLATE,
       AUX_DE_BOOR,
       AUX_ND_BOOR_EVAL,
       AUX_FINITE_DIFF,
       AUX_QR,
       AUX_QP,
+      AUX_IPQP,
       AUX_NLP,
       AUX_SQPMETHOD,
       AUX_LDL,
@@ -92,13 +92,23 @@ class RealtypeSX : public ConstantSX {
 
     /// Destructor
     ~RealtypeSX() override {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+      // The entry may already refer to a replacement created by another thread
+      auto it = cached_constants_.find(value);
+      if (it!=cached_constants_.end() && it->second==this) cached_constants_.erase(it);
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
       size_t num_erased = cached_constants_.erase(value);
       assert(num_erased==1);
       (void)num_erased;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     }
 
     /// Static creator function (use instead of constructor)
     inline static RealtypeSX* create(double value) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
       // Try to find the constant
       CACHING_MAP<double, RealtypeSX*>::iterator it = cached_constants_.find(value);
 
@@ -112,6 +122,13 @@ class RealtypeSX : public ConstantSX {
 
         // Return it to caller
         return n;
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      } else if (it->second->count==0) {
+        // Being deleted by another thread, replace it
+        RealtypeSX* n = new RealtypeSX(value);
+        it->second = n;
+        return n;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
       } else { // Else, returned the object
         return it->second;
       }
@@ -156,13 +173,23 @@ class IntegerSX : public ConstantSX {
 
     /// Destructor
     ~IntegerSX() override {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+      // The entry may already refer to a replacement created by another thread
+      auto it = cached_constants_.find(value);
+      if (it!=cached_constants_.end() && it->second==this) cached_constants_.erase(it);
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
       size_t num_erased = cached_constants_.erase(value);
       assert(num_erased==1);
       (void)num_erased;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     }
 
     /// Static creator function (use instead of constructor)
     inline static IntegerSX* create(casadi_int value) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
       // Try to find the constant
       CACHING_MAP<casadi_int, IntegerSX*>::iterator it = cached_constants_.find(value);
 
@@ -176,6 +203,13 @@ class IntegerSX : public ConstantSX {
 
         // Return it to caller
         return n;
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      } else if (it->second->count==0) {
+        // Being deleted by another thread, replace it
+        IntegerSX* n = new IntegerSX(value);
+        it->second = n;
+        return n;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
       } else { // Else, returned the object
         return it->second;
       }
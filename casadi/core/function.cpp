@@ -33,6 +33,7 @@
 #include "mapsum.hpp"
 #include "conic.hpp"
 #include "jit_function.hpp"
+#include "packed_tape.hpp"
 #include "serializing_stream.hpp"
 #include "serializer.hpp"
 
@@ -833,6 +834,18 @@ namespace casadi {
     }
   }
 
+  Function Function::jac_block(const std::vector<std::string>& s_out,
+                               const std::vector<std::string>& s_in) const {
+    try {
+      std::vector<casadi_int> oind, iind;
+      for (auto&& s : s_out) oind.push_back(index_out(s));
+      for (auto&& s : s_in) iind.push_back(index_in(s));
+      return (*this)->jac_block(oind, iind);
+    } catch (exception& e) {
+      THROW_ERROR("jac_block", e.what());
+    }
+  }
+
   bool Function::test_cast(const SharedObjectInternal* ptr) {
     return dynamic_cast<const FunctionInternal*>(ptr)!=nullptr;
   }
@@ -1123,6 +1136,16 @@ namespace casadi {
     fs.pack(*this);
   }
 
+  void Function::save_tape(const std::string &fname) const {
+    try {
+      const SXFunction* f = get<SXFunction>();
+      casadi_assert(f!=nullptr, "Packed tapes can only be saved for SX functions");
+      PackedTape::save(*f, fname);
+    } catch(std::exception& e) {
+      THROW_ERROR("save_tape", e.what());
+    }
+  }
+
   std::string Function::serialize(const Dict& opts) const {
     std::stringstream ss;
     serialize(ss, opts);
@@ -1197,6 +1220,11 @@ namespace casadi {
     return deserialize(s);
   }
 
+  Function Function::load_tape(const std::string& name, const std::string& fname,
+                               const Dict& opts) {
+    return create(new PackedTape(name, fname), opts);
+  }
+
   Function Function::load(const std::string& filename) {
     FileDeserializer fs(filename);
     auto t = fs.pop_type();
@@ -401,6 +401,18 @@ namespace casadi {
       */
     Function jac() const;
 
+    /** \brief Calculate selected Jacobian blocks
+      *
+      * Like jac(), but only the blocks of the outputs \a s_out with respect to the
+      * inputs \a s_in are generated, sorted in the same way. The other blocks and
+      * their sparsity patterns are never calculated.
+      * E.g. f:(x,y,p)->(r,s) and jac_block({"s"}, {"p"}) results in the function
+      * jac_f:(x,y,p,r,s)->(ds_dp)
+      * This function is cached.
+      */
+    Function jac_block(const std::vector<std::string>& s_out,
+                       const std::vector<std::string>& s_in) const;
+
     ///@{
     /** \brief Evaluate the function symbolically or numerically  */
     void call(const std::vector<DM> &arg, std::vector<DM>& SWIG_OUTPUT(res),
@@ -740,6 +752,13 @@ namespace casadi {
     std::string serialize(const Dict& opts=Dict()) const;
     void save(const std::string &fname, const Dict& opts=Dict()) const;
 
+    /** \brief Write the algorithm of an SX function to a packed tape file
+     *
+     * The file can be evaluated with load_tape without holding the expression
+     * graph or the full algorithm in memory.
+     */
+    void save_tape(const std::string &fname) const;
+
     std::string export_code(const std::string& lang, const Dict& options=Dict()) const;
 #ifndef SWIG
     void export_code(const std::string& lang,
@@ -951,6 +970,14 @@ namespace casadi {
     /** \brief Build function from serialization */
     static Function load(const std::string& filename);
 
+    /** \brief Numerical function streamed from a packed tape file
+     *
+     * The file, written by save_tape, is memory-mapped and evaluated chunk by chunk.
+     * Only numerical evaluation is supported.
+     */
+    static Function load_tape(const std::string& name, const std::string& fname,
+                              const Dict& opts=Dict());
+
     /** \brief Build function from serialization */
     static Function deserialize(DeserializingStream& s);
 
@@ -27,6 +27,7 @@
 #include "casadi_call.hpp"
 #include "casadi_misc.hpp"
 #include "global_options.hpp"
+#include "profiler.hpp"
 #include "external.hpp"
 #include "finite_differences.hpp"
 #include "serializing_stream.hpp"
@@ -712,6 +713,9 @@ namespace casadi {
 
     auto m = static_cast<ProtoFunctionMemory*>(mem);
 
+    // Hierarchical profiling, no-op unless active
+    ProfilerScope prof(name_);
+
     // Reset statistics
     for (auto&& s : m->fstats) s.second.reset();
     if (m->t_total) m->t_total->tic();
@@ -2059,6 +2063,54 @@ namespace casadi {
     return f;
   }
 
+  Function FunctionInternal::jac_block(const std::vector<casadi_int>& oind,
+                                       const std::vector<casadi_int>& iind) const {
+    // Used wrapped function if jacobian not available
+    if (!has_jac()) {
+      // Derivative information must be available
+      casadi_assert(has_derivative(),
+                    "Derivatives cannot be calculated for " + name_);
+      return wrap()->jac_block(oind, iind);
+    }
+
+    // Names of outputs, also identifying the cached instance
+    std::vector<std::string> onames;
+    onames.reserve(oind.size()*iind.size());
+    for (casadi_int o : oind) {
+      casadi_assert(o>=0 && o<n_out_, "Output index out of bounds");
+      for (casadi_int i : iind) {
+        casadi_assert(i>=0 && i<n_in_, "Input index out of bounds");
+        onames.push_back("D" + name_out_[o] + "D" + name_in_[i]);
+      }
+    }
+
+    // Retrieve/generate cached
+    Function f;
+    string fname = "JAC_" + name_;
+    string suffix = join(onames, ",");
+    if (!incache(fname, f, suffix)) {
+      // Names of inputs
+      std::vector<std::string> inames = name_in_;
+      inames.insert(inames.end(), name_out_.begin(), name_out_.end());
+
+      // Options
+      Dict opts;
+      opts["derivative_of"] = self();
+
+      // Generate derivative function
+      casadi_assert_dev(enable_jacobian_);
+      f = get_jac_block(fname, oind, iind, inames, onames, opts);
+
+      // Consistency check
+      casadi_assert(f.n_in()==inames.size(),
+                    "Return function has wrong number of inputs");
+      casadi_assert(f.n_out()==onames.size(),
+                    "Return function has wrong number of outputs");
+      tocache(f, suffix);
+    }
+    return f;
+  }
+
   Function FunctionInternal::jacobian() const {
     // Used wrapped function if jacobian not available
     if (!has_jacobian()) {
@@ -2117,6 +2169,21 @@ namespace casadi {
     casadi_error("'get_jac' not defined for " + class_name());
   }
 
+  Function FunctionInternal::
+  get_jac_block(const std::string& name,
+                const std::vector<casadi_int>& oind,
+                const std::vector<casadi_int>& iind,
+                const std::vector<std::string>& inames,
+                const std::vector<std::string>& onames,
+                const Dict& opts) const {
+    // Select the blocks from all Jacobian blocks
+    std::vector<casadi_int> order_out;
+    for (casadi_int o : oind) {
+      for (casadi_int i : iind) order_out.push_back(o*n_in_ + i);
+    }
+    return jac().slice(name, range(n_in_ + n_out_), order_out, opts);
+  }
+
   void FunctionInternal::codegen(CodeGenerator& g, const std::string& fname) const {
     // Define function
     g << "/* " << definition() << " */\n";
@@ -461,6 +461,18 @@ namespace casadi {
                              const Dict& opts) const;
     ///@}
 
+    ///@{
+    /** \brief Return selected Jacobian blocks, without calculating the others */
+    Function jac_block(const std::vector<casadi_int>& oind,
+                       const std::vector<casadi_int>& iind) const;
+    virtual Function get_jac_block(const std::string& name,
+                                   const std::vector<casadi_int>& oind,
+                                   const std::vector<casadi_int>& iind,
+                                   const std::vector<std::string>& inames,
+                                   const std::vector<std::string>& onames,
+                                   const Dict& opts) const;
+    ///@}
+
     ///@{
     /** \brief Return function that calculates forward derivatives
      *    forward(nfwd) returns a cached instance if available,
@@ -647,6 +647,7 @@ namespace casadi {
 
     ///@{
     // Hessian and (optionally) gradient
+    // For SX, the option "edge_pushing" avoids the Jacobian of the gradient
     inline friend MatType hessian(const MatType &ex, const MatType &arg,
         const Dict& opts = Dict()) {
       return MatType::hessian(ex, arg, opts);
@@ -29,6 +29,7 @@
 namespace casadi {
 
   bool GlobalOptions::simplification_on_the_fly = true;
+  bool GlobalOptions::hash_consing = false;
   bool GlobalOptions::hierarchical_sparsity = true;
 
   std::string GlobalOptions::casadipath;
@@ -36,6 +37,8 @@ namespace casadi {
 
   casadi_int GlobalOptions::max_num_dir = 64;
 
+  casadi_int GlobalOptions::max_num_threads_ad = 1;
+
   // By default, use zero-based indexing
   casadi_int GlobalOptions::start_index = 0;
 
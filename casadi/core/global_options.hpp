@@ -58,6 +58,13 @@ namespace casadi {
       */
       static bool simplification_on_the_fly;
 
+      /** \brief Indicates whether identical SX operations should share a node.
+      * Unary and binary operations on the same arguments are looked up in a table
+      * before a new node is created, e.g. sin(x)*y and y*sin(x) become the same node
+      * Default: false
+      */
+      static bool hash_consing;
+
       static std::string casadipath;
 
       static std::string casadi_include_path;
@@ -66,6 +73,13 @@ namespace casadi {
 
       static casadi_int max_num_dir;
 
+      /** \brief Maximum number of threads for symbolic directional derivatives of SX functions.
+      * The seed directions are partitioned between the threads.
+      * Only used when built with WITH_THREADSAFE_SYMBOLICS
+      * Default: 1
+      */
+      static casadi_int max_num_threads_ad;
+
       static casadi_int start_index;
 
 #endif //SWIG
@@ -73,6 +87,10 @@ namespace casadi {
       static void setSimplificationOnTheFly(bool flag) { simplification_on_the_fly = flag; }
       static bool getSimplificationOnTheFly() { return simplification_on_the_fly; }
 
+      // Setter and getter for hash_consing
+      static void setHashConsing(bool flag) { hash_consing = flag; }
+      static bool getHashConsing() { return hash_consing; }
+
       // Setter and getter for hierarchical_sparsity
       static void setHierarchicalSparsity(bool flag) { hierarchical_sparsity = flag; }
       static bool getHierarchicalSparsity() { return hierarchical_sparsity; }
@@ -86,6 +104,9 @@ namespace casadi {
       static void setMaxNumDir(casadi_int ndir) { max_num_dir=ndir; }
       static casadi_int getMaxNumDir() { return max_num_dir; }
 
+      static void setMaxNumThreadsAD(casadi_int n) { max_num_threads_ad=n; }
+      static casadi_int getMaxNumThreadsAD() { return max_num_threads_ad; }
+
   };
 
 } // namespace casadi
@@ -1022,6 +1022,10 @@ namespace casadi {
 
     // Default options
     nk_ = 20;
+    parallelization_ = "serial";
+    parareal_blocks_ = 0;
+    parareal_tol_ = 1e-10;
+    parareal_max_iter_ = -1;
   }
 
   FixedStepIntegrator::~FixedStepIntegrator() {
@@ -1038,7 +1042,24 @@ namespace casadi {
         "Implement as MX Function (codegeneratable/serializable) default: false"}},
       {"simplify_options",
         {OT_DICT,
-        "Any options to pass to simplified form Function constructor"}}
+        "Any options to pass to simplified form Function constructor"}},
+      {"parareal_blocks",
+        {OT_INT,
+        "Split the finite elements into this many time blocks and integrate them "
+        "concurrently with the Parareal iteration. Must divide number_of_finite_elements. "
+        "Used when integrating over the whole horizon in one step. Default: 0 (sequential)"}},
+      {"parareal_tol",
+        {OT_DOUBLE,
+        "Parareal stopping tolerance on the change of the block initial states "
+        "(infinity norm) [default: 1e-10]"}},
+      {"parareal_max_iter",
+        {OT_INT,
+        "Maximum number of Parareal iterations [default: parareal_blocks, "
+        "which reproduces the sequential result]"}},
+      {"parallelization",
+        {OT_STRING,
+        "Parallelization of the Parareal block propagation: serial|openmp|thread "
+        "[default: serial]"}}
       }
   };
 
@@ -1109,6 +1130,14 @@ namespace casadi {
     for (auto&& op : opts) {
       if (op.first=="number_of_finite_elements") {
         nk_ = op.second;
+      } else if (op.first=="parareal_blocks") {
+        parareal_blocks_ = op.second;
+      } else if (op.first=="parareal_tol") {
+        parareal_tol_ = op.second;
+      } else if (op.first=="parareal_max_iter") {
+        parareal_max_iter_ = op.second;
+      } else if (op.first=="parallelization") {
+        parallelization_ = op.second.to_string();
       }
     }
 
@@ -1116,6 +1145,17 @@ namespace casadi {
     casadi_assert_dev(nk_>0);
     h_ = static_cast<double>(grid_.back() - grid_.front())/static_cast<double>(nk_);
 
+    // Parareal
+    if (parareal_blocks_>1) {
+      casadi_assert(nk_ % parareal_blocks_ == 0,
+        "'parareal_blocks' (" + str(parareal_blocks_) + ") must divide "
+        "'number_of_finite_elements' (" + str(nk_) + ")");
+      if (parareal_max_iter_<0) parareal_max_iter_ = parareal_blocks_;
+      casadi_assert(parareal_max_iter_>0, "'parareal_max_iter' must be positive");
+    } else {
+      parareal_blocks_ = 0;
+    }
+
     // Setup discrete time dynamics
     setupFG();
 
@@ -1124,6 +1164,35 @@ namespace casadi {
     nRZ_ =  G_.is_null() ? 0 : G_.nnz_in(RDAE_RZ);
   }
 
+  void FixedStepIntegrator::finalize() {
+    if (parareal_blocks_>1) {
+      casadi_int nb = parareal_blocks_, bs = nk_/nb;
+
+      // Coarse propagator: the same method, one finite element per block
+      Dict coarse_opts = opts_;
+      for (const char* op : {"grid", "output_t0", "parareal_blocks", "parareal_tol",
+                             "parareal_max_iter", "parallelization", "simplify"}) {
+        coarse_opts.erase(op);
+      }
+      coarse_opts["t0"] = static_cast<double>(grid_.front());
+      coarse_opts["tf"] = static_cast<double>(grid_.front()) + static_cast<double>(bs)*h_;
+      coarse_opts["number_of_finite_elements"] = 1;
+      coarse_intg_ = integrator(name_ + "_coarse", plugin_name(), oracle_, coarse_opts);
+      auto coarse = coarse_intg_.get<FixedStepIntegrator>();
+      parareal_coarse_ = coarse->getExplicit();
+
+      // Fine propagator: all elements of a block in sequence, blocks mapped
+      Function block = getExplicit().mapaccum(name_ + "_block", bs,
+        std::vector<casadi_int>{DAE_X, DAE_Z}, std::vector<casadi_int>{DAE_ODE, DAE_ALG});
+      parareal_fine_ = block.map(nb, parallelization_);
+      alloc(parareal_coarse_);
+      alloc(parareal_fine_);
+    }
+
+    // Call the base class finalize
+    Integrator::finalize();
+  }
+
   int FixedStepIntegrator::init_mem(void* mem) const {
     if (Integrator::init_mem(mem)) return 1;
     auto m = static_cast<FixedStepMemory*>(mem);
@@ -1153,6 +1222,22 @@ namespace casadi {
     m->rx_prev.resize(nrx_);
     m->RZ_prev.resize(nRZ_);
     m->rq_prev.resize(nrq_);
+
+    // Parareal work vectors
+    if (parareal_blocks_>1) {
+      casadi_int nb = parareal_blocks_;
+      m->pr_t.resize(nk_);
+      m->pr_p.resize(np_*nk_);
+      m->pr_U.resize(nx_*(nb+1));
+      m->pr_Z0.resize(nZ_*nb);
+      m->pr_Zc.resize(nZ_*nb);
+      m->pr_G.resize(nx_*nb);
+      m->pr_Gnew.resize(nx_);
+      m->pr_X.resize(nx_*nk_);
+      m->pr_Z.resize(nZ_*nk_);
+      m->pr_Q.resize(nq_*nk_);
+    }
+    m->pr_iter = 0;
     return 0;
   }
 
@@ -1165,6 +1250,9 @@ namespace casadi {
     k_out = std::min(k_out, nk_); //  make sure that rounding errors does not result in k_out>nk_
     casadi_assert_dev(k_out>=0);
 
+    // Whole horizon in one go: integrate the blocks concurrently
+    if (parareal_blocks_>1 && m->k==0 && k_out==nk_) parareal(m);
+
     // Explicit discrete time dynamics
     const Function& F = getExplicit();
 
@@ -1209,6 +1297,105 @@ namespace casadi {
     casadi_copy(get_ptr(m->q), nq_, q);
   }
 
+  void FixedStepIntegrator::parareal(FixedStepMemory* m) const {
+    casadi_int nb = parareal_blocks_, bs = nk_/nb;
+    double H = static_cast<double>(bs)*h_;
+    double* U = get_ptr(m->pr_U);
+    double* X = get_ptr(m->pr_X);
+    double* Z = get_ptr(m->pr_Z);
+
+    // Element times and (repeated) parameters for the fine propagation
+    for (casadi_int k=0; k<nk_; ++k) {
+      m->pr_t[k] = static_cast<double>(grid_.front()) + static_cast<double>(k)*h_;
+      casadi_copy(get_ptr(m->p), np_, get_ptr(m->pr_p)+k*np_);
+    }
+
+    // Initial guesses for the discrete time algebraic variables, from reset
+    for (casadi_int b=0; b<nb; ++b) {
+      casadi_copy(get_ptr(m->Z), nZ_, get_ptr(m->pr_Z0)+b*nZ_);
+      casadi_copy(get_ptr(m->Z), nZ_, get_ptr(m->pr_Zc)+b*nZ_);
+    }
+
+    // Coarse step over block b, starting at U_b: writes m->pr_Gnew
+    auto coarse = [&](casadi_int b) {
+      double tb = static_cast<double>(grid_.front()) + static_cast<double>(b)*H;
+      fill_n(m->arg, parareal_coarse_.n_in(), nullptr);
+      m->arg[DAE_T] = &tb;
+      m->arg[DAE_X] = U+b*nx_;
+      m->arg[DAE_Z] = get_ptr(m->pr_Zc)+b*nZ_;
+      m->arg[DAE_P] = get_ptr(m->p);
+      fill_n(m->res, parareal_coarse_.n_out(), nullptr);
+      m->res[DAE_ODE] = get_ptr(m->pr_Gnew);
+      m->res[DAE_ALG] = get_ptr(m->pr_Zc)+b*nZ_;
+      parareal_coarse_(m->arg, m->res, m->iw, m->w);
+    };
+
+    // Initial sequential coarse sweep
+    casadi_copy(get_ptr(m->x), nx_, U);
+    for (casadi_int b=0; b<nb; ++b) {
+      coarse(b);
+      casadi_copy(get_ptr(m->pr_Gnew), nx_, get_ptr(m->pr_G)+b*nx_);
+      casadi_copy(get_ptr(m->pr_Gnew), nx_, U+(b+1)*nx_);
+    }
+
+    // Parareal iterations
+    for (m->pr_iter=1; ; ++m->pr_iter) {
+      // Fine propagation of all blocks, independent of each other
+      fill_n(m->arg, parareal_fine_.n_in(), nullptr);
+      m->arg[DAE_T] = get_ptr(m->pr_t);
+      m->arg[DAE_X] = U;
+      m->arg[DAE_Z] = get_ptr(m->pr_Z0);
+      m->arg[DAE_P] = get_ptr(m->pr_p);
+      fill_n(m->res, parareal_fine_.n_out(), nullptr);
+      m->res[DAE_ODE] = X;
+      m->res[DAE_ALG] = Z;
+      m->res[DAE_QUAD] = get_ptr(m->pr_Q);
+      parareal_fine_(m->arg, m->res, m->iw, m->w);
+
+      // After nb sweeps, every block has started from its exact initial state
+      if (m->pr_iter>=std::min(parareal_max_iter_, nb)) break;
+
+      // Sequential correction: U_{b+1} = G(U_b) + F(U_b^old) - G(U_b^old)
+      double du = 0;
+      for (casadi_int b=0; b<nb; ++b) {
+        coarse(b);
+        double* Gb = get_ptr(m->pr_G)+b*nx_;
+        double* Ub = U+(b+1)*nx_;
+        const double* Fb = X+((b+1)*bs-1)*nx_;
+        for (casadi_int i=0; i<nx_; ++i) {
+          double u = m->pr_Gnew[i] + Fb[i] - Gb[i];
+          du = std::fmax(du, std::fabs(u - Ub[i]));
+          Ub[i] = u;
+          Gb[i] = m->pr_Gnew[i];
+        }
+      }
+      if (verbose_) casadi_message("Parareal iteration " + str(m->pr_iter)
+                                   + ": |dU| = " + str(du));
+      if (du<=parareal_tol_) break;
+
+      // Warm start the algebraic variables with the end of the preceding block
+      for (casadi_int b=1; b<nb; ++b) {
+        casadi_copy(Z+(b*bs-1)*nZ_, nZ_, get_ptr(m->pr_Z0)+b*nZ_);
+      }
+    }
+    if (verbose_) casadi_message("Parareal done after " + str(m->pr_iter) + " iterations");
+
+    // Accumulate quadratures and tape in the sequential order
+    for (casadi_int k=0; k<nk_; ++k) {
+      casadi_axpy(nq_, 1., get_ptr(m->pr_Q)+k*nq_, get_ptr(m->q));
+      if (nrx_>0) {
+        casadi_copy(X+k*nx_, nx_, get_ptr(m->x_tape.at(k+1)));
+        casadi_copy(Z+k*nZ_, nZ_, get_ptr(m->Z_tape.at(k)));
+      }
+    }
+
+    // State at the end of the horizon
+    casadi_copy(X+(nk_-1)*nx_, nx_, get_ptr(m->x));
+    casadi_copy(Z+(nk_-1)*nZ_, nZ_, get_ptr(m->Z));
+    m->k = nk_;
+    m->t = static_cast<double>(grid_.front()) + static_cast<double>(nk_)*h_;
+  }
+
   void FixedStepIntegrator::retreat(IntegratorMemory* mem, double t,
                                     double* rx, double* rz, double* rq) const {
     auto m = static_cast<FixedStepMemory*>(mem);
@@ -1533,23 +1720,38 @@ namespace casadi {
   void FixedStepIntegrator::serialize_body(SerializingStream &s) const {
     Integrator::serialize_body(s);
 
-    s.version("FixedStepIntegrator", 1);
+    s.version("FixedStepIntegrator", 2);
     s.pack("FixedStepIntegrator::F", F_);
     s.pack("FixedStepIntegrator::G", G_);
     s.pack("FixedStepIntegrator::nk", nk_);
     s.pack("FixedStepIntegrator::h", h_);
     s.pack("FixedStepIntegrator::nZ", nZ_);
     s.pack("FixedStepIntegrator::nRZ", nRZ_);
+    s.pack("FixedStepIntegrator::parallelization", parallelization_);
+    s.pack("FixedStepIntegrator::parareal_blocks", parareal_blocks_);
+    s.pack("FixedStepIntegrator::parareal_tol", parareal_tol_);
+    s.pack("FixedStepIntegrator::parareal_max_iter", parareal_max_iter_);
   }
 
   FixedStepIntegrator::FixedStepIntegrator(DeserializingStream & s) : Integrator(s) {
-    s.version("FixedStepIntegrator", 1);
+    int version = s.version("FixedStepIntegrator", 1, 2);
     s.unpack("FixedStepIntegrator::F", F_);
     s.unpack("FixedStepIntegrator::G", G_);
     s.unpack("FixedStepIntegrator::nk", nk_);
     s.unpack("FixedStepIntegrator::h", h_);
     s.unpack("FixedStepIntegrator::nZ", nZ_);
     s.unpack("FixedStepIntegrator::nRZ", nRZ_);
+    if (version>=2) {
+      s.unpack("FixedStepIntegrator::parallelization", parallelization_);
+      s.unpack("FixedStepIntegrator::parareal_blocks", parareal_blocks_);
+      s.unpack("FixedStepIntegrator::parareal_tol", parareal_tol_);
+      s.unpack("FixedStepIntegrator::parareal_max_iter", parareal_max_iter_);
+    } else {
+      parallelization_ = "serial";
+      parareal_blocks_ = 0;
+      parareal_tol_ = 1e-10;
+      parareal_max_iter_ = -1;
+    }
   }
 
   void ImplicitFixedStepIntegrator::serialize_body(SerializingStream &s) const {
@@ -260,6 +260,15 @@ namespace casadi {
 
     // Tape
     std::vector<std::vector<double> > x_tape, Z_tape;
+
+    /// Parareal work: element times, parameters, block initial states and guesses
+    std::vector<double> pr_t, pr_p, pr_U, pr_Z0, pr_Zc, pr_G, pr_Gnew;
+
+    /// Parareal work: fine trajectories
+    std::vector<double> pr_X, pr_Z, pr_Q;
+
+    /// Parareal iterations in the last call
+    casadi_int pr_iter;
   };
 
   class CASADI_EXPORT FixedStepIntegrator : public Integrator {
@@ -280,6 +289,9 @@ namespace casadi {
     /// Initialize stage
     void init(const Dict& opts) override;
 
+    /// Finalize initialization, after the discrete time dynamics are available
+    void finalize() override;
+
     /** Helper for a more powerful 'integrator' factory */
     Function create_advanced(const Dict& opts) override;
 
@@ -329,6 +341,23 @@ namespace casadi {
     /// Number of algebraic variables for the discrete time integration
     casadi_int nZ_, nRZ_;
 
+    /// Parallelization of the fine (per block) propagation
+    std::string parallelization_;
+
+    /// Parareal: number of time blocks, tolerance, maximum number of iterations
+    casadi_int parareal_blocks_;
+    double parareal_tol_;
+    casadi_int parareal_max_iter_;
+
+    /// Parareal: fine propagation over all blocks, coarse step over one block
+    Function parareal_fine_, parareal_coarse_;
+
+    /// Coarse integrator, owns parareal_coarse_
+    Function coarse_intg_;
+
+    /** \brief Take all finite elements with the Parareal iteration */
+    void parareal(FixedStepMemory* m) const;
+
     /** \brief Serialize an object without type information */
     void serialize_body(SerializingStream &s) const override;
 
@@ -25,6 +25,7 @@
 
 #include "linsol_internal.hpp"
 #include "mx_node.hpp"
+#include "profiler.hpp"
 
 using namespace std;
 namespace casadi {
@@ -114,6 +115,7 @@ namespace casadi {
     // Factorization will be needed after this step
     m->is_sfact = m->is_nfact = false;
 
+    ProfilerScope prof((*this)->name_, ":sfact");
     if (m->t_total) m->fstats.at("sfact").tic();
     // Perform pivoting
     if ((*this)->sfact(m, A)) return 1;
@@ -139,6 +141,7 @@ namespace casadi {
     }
 
     m->is_nfact = false;
+    ProfilerScope prof((*this)->name_, ":nfact");
     if (m->t_total) m->fstats.at("nfact").tic();
     if ((*this)->nfact(m, A)) return 1;
     if (m->t_total) m->fstats.at("nfact").toc();
@@ -171,6 +174,7 @@ namespace casadi {
   int Linsol::solve(const double* A, double* x, casadi_int nrhs, bool tr, int mem) const {
     auto m = static_cast<LinsolMemory*>((*this)->memory(mem));
     casadi_assert(m->is_nfact, "Linear system has not been factorized");
+    ProfilerScope prof((*this)->name_, ":solve");
     if (m->t_total) m->fstats.at("solve").tic();
     int ret = (*this)->solve(m, A, x, nrhs, tr);
     if (m->t_total) m->fstats.at("solve").toc();
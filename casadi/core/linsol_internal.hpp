@@ -143,6 +143,8 @@ namespace casadi {
   protected:
     /** \brief Deserializing constructor */
     explicit LinsolInternal(DeserializingStream& s);
+
+    friend class Linsol;
   };
 
 } // namespace casadi
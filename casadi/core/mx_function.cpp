@@ -48,6 +48,9 @@ namespace casadi {
                          const std::vector<std::string>& name_in,
                          const std::vector<std::string>& name_out) :
     XFunction<MXFunction, MX, MXNode>(name, inputv, outputv, name_in, name_out) {
+
+    // Default (persistent) options
+    profile_instructions_ = false;
   }
 
   MXFunction::~MXFunction() {
@@ -61,7 +64,12 @@ namespace casadi {
         "Default input values"}},
       {"live_variables",
        {OT_BOOL,
-        "Reuse variables in the work vector"}}
+        "Reuse variables in the work vector"}},
+      {"profile_instructions",
+       {OT_BOOL,
+        "Count executions and accumulate time per operation type and per embedded "
+        "function during numerical evaluation, reported as 'instructions' in "
+        "the statistics and, while the Profiler is active, in its call tree and trace [false]"}}
      }
   };
 
@@ -69,6 +77,7 @@ namespace casadi {
     Dict opts = FunctionInternal::generate_options(is_temp);
     //opts["default_in"] = default_in_;
     opts["live_variables"] = live_variables_;
+    opts["profile_instructions"] = profile_instructions_;
     return opts;
   }
 
@@ -110,6 +119,8 @@ namespace casadi {
         default_in_ = op.second;
       } else if (op.first=="live_variables") {
         live_variables_ = op.second;
+      } else if (op.first=="profile_instructions") {
+        profile_instructions_ = op.second;
       }
     }
 
@@ -387,6 +398,25 @@ namespace casadi {
         break;
       }
     }
+
+    // Instruction categories for profiling
+    if (profile_instructions_) set_instr_profile();
+  }
+
+  void MXFunction::set_instr_profile() {
+    std::vector<std::string> instr_name(algorithm_.size());
+    std::vector<bool> instr_nested(algorithm_.size(), false);
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      if (e.op==OP_CALL) {
+        // One category per embedded function
+        instr_name[k] = "call:" + e.data.which_function().name();
+        instr_nested[k] = true;
+      } else {
+        instr_name[k] = casadi_math<double>::name(e.op);
+      }
+    }
+    init_instr_profile(instr_name, instr_nested);
   }
 
   int MXFunction::eval(const double** arg, double** res,
@@ -404,9 +434,20 @@ namespace casadi {
                    + str(free_vars_) + " are free.");
     }
 
+    // Instruction profiling
+    XFunctionMemory* prof = nullptr;
+    uint64_t t0 = 0;
+    if (profile_instructions_) {
+      prof = static_cast<XFunctionMemory*>(mem);
+      std::fill(prof->instr_n_call.begin(), prof->instr_n_call.end(), 0);
+      std::fill(prof->instr_ticks.begin(), prof->instr_ticks.end(), 0);
+    }
+
     // Evaluate all of the nodes of the algorithm:
     // should only evaluate nodes that have not yet been calculated!
-    for (auto&& e : algorithm_) {
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      if (prof) t0 = Profiler::tick();
       if (e.op==OP_INPUT) {
         // Pass an input
         double *w1 = w+workloc_[e.res.front()];
@@ -435,7 +476,12 @@ namespace casadi {
         // Evaluate
         if (e.data->eval(arg1, res1, iw, w)) return 1;
       }
+      if (prof) {
+        prof->instr_n_call[instr_cat_[k]]++;
+        prof->instr_ticks[instr_cat_[k]] += Profiler::tick() - t0;
+      }
     }
+    if (prof) instr_profile_done(prof);
     return 0;
   }
 
@@ -1683,7 +1729,7 @@ namespace casadi {
   void MXFunction::serialize_body(SerializingStream &s) const {
     XFunction<MXFunction, MX, MXNode>::serialize_body(s);
 
-    s.version("MXFunction", 1);
+    s.version("MXFunction", 2);
     s.pack("MXFunction::n_instr", algorithm_.size());
 
     // Loop over algorithm
@@ -1697,13 +1743,14 @@ namespace casadi {
     s.pack("MXFunction::free_vars", free_vars_);
     s.pack("MXFunction::default_in", default_in_);
     s.pack("MXFunction::live_variables", live_variables_);
+    s.pack("MXFunction::profile_instructions", profile_instructions_);
 
     XFunction<MXFunction, MX, MXNode>::delayed_serialize_members(s);
   }
 
 
   MXFunction::MXFunction(DeserializingStream& s) : XFunction<MXFunction, MX, MXNode>(s) {
-    s.version("MXFunction", 1);
+    int version = s.version("MXFunction", 1, 2);
     size_t n_instructions;
     s.unpack("MXFunction::n_instr", n_instructions);
     algorithm_.resize(n_instructions);
@@ -1719,8 +1766,15 @@ namespace casadi {
     s.unpack("MXFunction::free_vars", free_vars_);
     s.unpack("MXFunction::default_in", default_in_);
     s.unpack("MXFunction::live_variables", live_variables_);
+    if (version >= 2) {
+      s.unpack("MXFunction::profile_instructions", profile_instructions_);
+    } else {
+      profile_instructions_ = false;
+    }
 
     XFunction<MXFunction, MX, MXNode>::delayed_deserialize_members(s);
+
+    if (profile_instructions_) set_instr_profile();
   }
 
   ProtoFunction* MXFunction::deserialize(DeserializingStream& s) {
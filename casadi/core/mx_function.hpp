@@ -80,6 +80,12 @@ namespace casadi {
     /// Live variables?
     bool live_variables_;
 
+    /// Profile instructions?
+    bool profile_instructions_;
+
+    /** \brief Set up instruction categories for profiling */
+    void set_instr_profile();
+
     /** \brief Constructor */
     MXFunction(const std::string& name,
       const std::vector<MX>& input, const std::vector<MX>& output,
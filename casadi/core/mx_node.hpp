@@ -32,6 +32,7 @@
 #include "calculus.hpp"
 #include "code_generator.hpp"
 #include "linsol.hpp"
+#include "node_pool.hpp"
 #include <vector>
 #include <stack>
 
@@ -55,6 +56,14 @@ namespace casadi {
     /** \brief  Destructor */
     ~MXNode() override=0;
 
+#ifdef CASADI_WITH_NODE_POOL
+    ///@{
+    /** \brief  Allocate from the node pool */
+    static void* operator new(std::size_t sz) { return NodePool::allocate(sz);}
+    static void operator delete(void* p, std::size_t sz) { NodePool::deallocate(p, sz);}
+    ///@}
+#endif // CASADI_WITH_NODE_POOL
+
     /** \brief Check the truth value of this node
      */
     virtual bool __nonzero__() const;
@@ -206,6 +206,8 @@ namespace casadi {
     no_nlp_grad_ = false;
     error_on_fail_ = false;
     sens_linsol_ = "qr";
+    warm_start_cache_ = 0;
+    warm_start_cache_radius_ = inf;
   }
 
   Nlpsol::~Nlpsol() {
@@ -315,7 +317,16 @@ namespace casadi {
         "Linear solver used for parametric sensitivities (default 'qr')."}},
       {"sens_linsol_options",
        {OT_DICT,
-        "Linear solver options used for parametric sensitivities."}}
+        "Linear solver options used for parametric sensitivities."}},
+      {"warm_start_cache",
+       {OT_INT,
+        "Number of converged solutions to keep, keyed on the parameter values. "
+        "When positive, x0, lam_x0 and lam_g0 are replaced by the cached solution "
+        "whose parameter values are closest to the current ones (default 0: disabled)."}},
+      {"warm_start_cache_radius",
+       {OT_DOUBLE,
+        "Only seed from cached solutions whose parameter values lie within "
+        "this Euclidean distance (default inf)."}}
      }
   };
 
@@ -359,8 +370,13 @@ namespace casadi {
         sens_linsol_ = op.second.to_string();
       } else if (op.first=="sens_linsol_options") {
         sens_linsol_options_ = op.second;
+      } else if (op.first=="warm_start_cache") {
+        warm_start_cache_ = op.second;
+      } else if (op.first=="warm_start_cache_radius") {
+        warm_start_cache_radius_ = op.second;
       }
     }
+    casadi_assert(warm_start_cache_>=0, "Option 'warm_start_cache' must be nonnegative");
 
     // Deprecated option
     if (calc_multipliers_) {
@@ -462,6 +478,10 @@ namespace casadi {
     m->add_stat("callback_fun");
     m->success = false;
     m->unified_return_status = SOLVER_RET_UNKNOWN;
+    m->ws_cache.resize(warm_start_cache_*(np_ + 2*nx_ + ng_));
+    m->ws_loc.assign(warm_start_cache_, -1);
+    m->ws_hits = m->ws_misses = 0;
+    m->ws_dist = nan;
     return 0;
   }
 
@@ -552,6 +572,57 @@ namespace casadi {
     }
   }
 
+  void Nlpsol::warm_start_lookup(NlpsolMemory* m) const {
+    auto d_nlp = &m->d_nlp;
+    casadi_int stride = np_ + 2*nx_ + ng_;
+    // Closest filled slot
+    casadi_int best = -1;
+    double best_dist = inf;
+    for (casadi_int i=0; i<warm_start_cache_ && m->ws_loc[i]>=0; ++i) {
+      const double* e = get_ptr(m->ws_cache) + m->ws_loc[i]*stride;
+      double dist = 0;
+      for (casadi_int k=0; k<np_; ++k) dist += sq(e[k] - (d_nlp->p ? d_nlp->p[k] : 0));
+      if (dist<best_dist) {
+        best_dist = dist;
+        best = i;
+      }
+    }
+    m->ws_dist = sqrt(best_dist);
+    if (best<0 || m->ws_dist>warm_start_cache_radius_) {
+      m->ws_misses++;
+      return;
+    }
+    m->ws_hits++;
+    // Move to front
+    casadi_int c = m->ws_loc[best];
+    for (casadi_int k=best; k>0; --k) m->ws_loc[k] = m->ws_loc[k-1];
+    m->ws_loc[0] = c;
+    // Seed primal and dual initial guess
+    const double* e = get_ptr(m->ws_cache) + c*stride + np_;
+    casadi_copy(e, nx_, d_nlp->z);
+    casadi_copy(e + nx_, nx_ + ng_, d_nlp->lam);
+  }
+
+  void Nlpsol::warm_start_store(NlpsolMemory* m) const {
+    auto d_nlp = &m->d_nlp;
+    casadi_int stride = np_ + 2*nx_ + ng_;
+    // Overwrite an entry with identical key, else the first free or least recently used slot
+    casadi_int i;
+    for (i=0; i<warm_start_cache_-1 && m->ws_loc[i]>=0; ++i) {
+      const double* e = get_ptr(m->ws_cache) + m->ws_loc[i]*stride;
+      casadi_int k;
+      for (k=0; k<np_; ++k) if (e[k]!=(d_nlp->p ? d_nlp->p[k] : 0)) break;
+      if (k==np_) break;
+    }
+    casadi_int c = m->ws_loc[i]>=0 ? m->ws_loc[i] : i;
+    for (casadi_int k=i; k>0; --k) m->ws_loc[k] = m->ws_loc[k-1];
+    m->ws_loc[0] = c;
+    double* e = get_ptr(m->ws_cache) + c*stride;
+    casadi_copy(d_nlp->p, np_, e);
+    casadi_copy(d_nlp->z, nx_, e + np_);
+    casadi_copy(d_nlp->lam, nx_ + ng_, e + np_ + nx_);
+  }
+
   int Nlpsol::eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
     auto m = static_cast<NlpsolMemory*>(mem);
 
@@ -586,6 +657,7 @@ namespace casadi {
     casadi_copy(x0, nx_, d_nlp->z);
     casadi_copy(lam_x0, nx_, d_nlp->lam);
     casadi_copy(lam_g0, ng_, d_nlp->lam + nx_);
+    if (warm_start_cache_>0) warm_start_lookup(m);
 
     // Set multipliers to nan
     casadi_fill(d_nlp->lam_p, np_, nan);
@@ -629,6 +701,9 @@ namespace casadi {
       bound_consistency(nx_+ng_, d_nlp->z, d_nlp->lam, d_nlp->lbz, d_nlp->ubz);
     }
 
+    // Remember converged solutions
+    if (warm_start_cache_>0 && m->success) warm_start_store(m);
+
     // Get optimal solution
     casadi_copy(d_nlp->z, nx_, x);
     casadi_copy(d_nlp->z + nx_, ng_, g);
@@ -976,6 +1051,11 @@ namespace casadi {
     auto m = static_cast<NlpsolMemory*>(mem);
     stats["success"] = m->success;
     stats["unified_return_status"] = string_from_UnifiedReturnStatus(m->unified_return_status);
+    if (warm_start_cache_>0) {
+      stats["warm_start_hits"] = m->ws_hits;
+      stats["warm_start_misses"] = m->ws_misses;
+      stats["warm_start_distance"] = m->ws_dist;
+    }
     return stats;
   }
 
@@ -993,7 +1073,7 @@ namespace casadi {
   void Nlpsol::serialize_body(SerializingStream &s) const {
     OracleFunction::serialize_body(s);
 
-    s.version("Nlpsol", 2);
+    s.version("Nlpsol", 3);
     s.pack("Nlpsol::nx", nx_);
     s.pack("Nlpsol::ng", ng_);
     s.pack("Nlpsol::np", np_);
@@ -1015,6 +1095,8 @@ namespace casadi {
     s.pack("Nlpsol::mi", mi_);
     s.pack("Nlpsol::sens_linsol", sens_linsol_);
     s.pack("Nlpsol::sens_linsol_options", sens_linsol_options_);
+    s.pack("Nlpsol::warm_start_cache", warm_start_cache_);
+    s.pack("Nlpsol::warm_start_cache_radius", warm_start_cache_radius_);
   }
 
   void Nlpsol::serialize_type(SerializingStream &s) const {
@@ -1027,7 +1109,7 @@ namespace casadi {
   }
 
   Nlpsol::Nlpsol(DeserializingStream & s) : OracleFunction(s) {
-    int version = s.version("Nlpsol", 1, 2);
+    int version = s.version("Nlpsol", 1, 3);
     s.unpack("Nlpsol::nx", nx_);
     s.unpack("Nlpsol::ng", ng_);
     s.unpack("Nlpsol::np", np_);
@@ -1053,6 +1135,13 @@ namespace casadi {
     } else {
       sens_linsol_ = "qr";
     }
+    if (version>=3) {
+      s.unpack("Nlpsol::warm_start_cache", warm_start_cache_);
+      s.unpack("Nlpsol::warm_start_cache_radius", warm_start_cache_radius_);
+    } else {
+      warm_start_cache_ = 0;
+      warm_start_cache_radius_ = inf;
+    }
     set_nlpsol_prob();
   }
 
@@ -44,6 +44,12 @@ namespace casadi {
     bool success;
     // Return status
     FunctionInternal::UnifiedReturnStatus unified_return_status;
+    // Warm-start cache: entries [p, x, lam_x, lam_g], slots ordered by recent use
+    std::vector<double> ws_cache;
+    std::vector<casadi_int> ws_loc;
+    // Warm-start cache statistics
+    casadi_int ws_hits, ws_misses;
+    double ws_dist;
   };
 
   /** \brief NLP solver storage class
@@ -92,6 +98,8 @@ namespace casadi {
     double min_lam_;
     bool no_nlp_grad_;
     std::vector<bool> discrete_;
+    casadi_int warm_start_cache_;
+    double warm_start_cache_radius_;
     ///@}
 
     // Mixed integer problem?
@@ -208,6 +216,12 @@ namespace casadi {
     // Get KKT function
     Function kkt() const;
 
+    /// Seed the initial guess from the closest cached solution, if any
+    void warm_start_lookup(NlpsolMemory* m) const;
+
+    /// Add the current solution to the warm-start cache
+    void warm_start_store(NlpsolMemory* m) const;
+
     // Make sure primal-dual solution is consistent with bounds
     static void bound_consistency(casadi_int n, double* z, double* lam,
                                   const double* lbz, const double* ubz);
@@ -0,0 +1,234 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "node_pool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#else // _WIN32
+#include <sys/mman.h>
+#endif // _WIN32
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif //CASADI_WITH_THREAD
+
+namespace casadi {
+
+  namespace {
+
+    // Slab size, also its alignment
+    const size_t pool_slab_size = 1 << 16;
+
+    // Size class granularity and number of size classes
+    const size_t pool_granularity = 16;
+    const size_t pool_n_class = 16;
+
+    // Header at the start of each slab
+    struct PoolSlab {
+      // Neighbours in the list of slabs with free space
+      PoolSlab *prev, *next;
+      // Freed objects, linked through their first word
+      void* free;
+      // Start of the never used tail, end of the slab
+      char *bump, *end;
+      // Size class, number of objects in use
+      size_t cls, n_live;
+    };
+
+    // Offset of the first object in a slab
+    const size_t pool_header_size = (sizeof(PoolSlab) + 63) / 64 * 64;
+
+    // Global pool state
+    struct PoolData {
+      // Slabs with free space, per size class
+      PoolSlab* avail[pool_n_class];
+      // Empty slabs held, per size class
+      size_t n_empty[pool_n_class];
+      // Objects in use, slabs held
+      size_t n_live, n_slab;
+#ifdef CASADI_WITH_THREAD
+      std::mutex mtx;
+#endif // CASADI_WITH_THREAD
+      PoolData() : n_live(0), n_slab(0) {
+        for (size_t i=0; i<pool_n_class; ++i) {
+          avail[i] = nullptr;
+          n_empty[i] = 0;
+        }
+      }
+    };
+
+    PoolData& pool_data() {
+      // Never destroyed, since nodes may be freed during static destruction
+      static PoolData* d = new PoolData();
+      return *d;
+    }
+
+    PoolSlab* pool_slab_alloc(size_t cls) {
+      void* p;
+#ifdef _WIN32
+      p = _aligned_malloc(pool_slab_size, pool_slab_size);
+      if (!p) throw std::bad_alloc();
+#else // _WIN32
+      // Map directly rather than through malloc, whose heap would be fragmented by
+      // the alignment padding. Over-allocate and unmap the unaligned ends.
+      void* m = mmap(nullptr, 2*pool_slab_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (m==MAP_FAILED) throw std::bad_alloc();
+      uintptr_t a = reinterpret_cast<uintptr_t>(m);
+      uintptr_t a_aligned = (a + pool_slab_size - 1) & ~static_cast<uintptr_t>(pool_slab_size-1);
+      if (a_aligned>a) munmap(m, a_aligned-a);
+      if (a_aligned+pool_slab_size < a+2*pool_slab_size) {
+        munmap(reinterpret_cast<void*>(a_aligned+pool_slab_size),
+               a+2*pool_slab_size-(a_aligned+pool_slab_size));
+      }
+      p = reinterpret_cast<void*>(a_aligned);
+#endif // _WIN32
+      PoolSlab* s = static_cast<PoolSlab*>(p);
+      s->prev = s->next = nullptr;
+      s->free = nullptr;
+      s->bump = static_cast<char*>(p) + pool_header_size;
+      s->end = static_cast<char*>(p) + pool_slab_size;
+      s->cls = cls;
+      s->n_live = 0;
+      return s;
+    }
+
+    void pool_slab_free(PoolSlab* s) {
+#ifdef _WIN32
+      _aligned_free(s);
+#else // _WIN32
+      munmap(s, pool_slab_size);
+#endif // _WIN32
+    }
+
+    // Add to the front of the free space list of its size class
+    void pool_link(PoolData& d, PoolSlab* s) {
+      s->prev = nullptr;
+      s->next = d.avail[s->cls];
+      if (s->next) s->next->prev = s;
+      d.avail[s->cls] = s;
+    }
+
+    // Remove from the free space list of its size class
+    void pool_unlink(PoolData& d, PoolSlab* s) {
+      if (s->prev) {
+        s->prev->next = s->next;
+      } else {
+        d.avail[s->cls] = s->next;
+      }
+      if (s->next) s->next->prev = s->prev;
+      s->prev = s->next = nullptr;
+    }
+
+    inline size_t pool_obj_size(size_t cls) {
+      return (cls+1)*pool_granularity;
+    }
+
+    inline bool pool_full(const PoolSlab* s) {
+      return !s->free && s->bump + pool_obj_size(s->cls) > s->end;
+    }
+
+  } // namespace
+
+  void* NodePool::allocate(size_t sz) {
+    if (sz==0 || sz>pool_n_class*pool_granularity) return ::operator new(sz);
+    size_t cls = (sz-1)/pool_granularity;
+    PoolData& d = pool_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    PoolSlab* s = d.avail[cls];
+    if (s==nullptr) {
+      s = pool_slab_alloc(cls);
+      d.n_slab++;
+      pool_link(d, s);
+    } else if (s->n_live==0) {
+      d.n_empty[cls]--;
+    }
+    void* p;
+    if (s->free) {
+      p = s->free;
+      s->free = *static_cast<void**>(p);
+    } else {
+      p = s->bump;
+      s->bump += pool_obj_size(cls);
+    }
+    s->n_live++;
+    d.n_live++;
+    if (pool_full(s)) pool_unlink(d, s);
+    return p;
+  }
+
+  void NodePool::deallocate(void* p, size_t sz) {
+    if (p==nullptr) return;
+    if (sz==0 || sz>pool_n_class*pool_granularity) {
+      ::operator delete(p);
+      return;
+    }
+    // Slabs are aligned to their size
+    PoolSlab* s = reinterpret_cast<PoolSlab*>(
+      reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(pool_slab_size-1));
+    PoolData& d = pool_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    if (pool_full(s)) pool_link(d, s);
+    *static_cast<void**>(p) = s->free;
+    s->free = p;
+    s->n_live--;
+    d.n_live--;
+    if (s->n_live==0) {
+      if (d.n_empty[s->cls]>0) {
+        // Release, keeping one empty slab per size class to avoid thrashing
+        pool_unlink(d, s);
+        pool_slab_free(s);
+        d.n_slab--;
+      } else {
+        d.n_empty[s->cls]++;
+      }
+    }
+  }
+
+  Dict NodePool::stats() {
+    PoolData& d = pool_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    Dict st;
+    st["n_live"] = static_cast<casadi_int>(d.n_live);
+    st["n_slab"] = static_cast<casadi_int>(d.n_slab);
+    st["bytes"] = static_cast<casadi_int>(d.n_slab*pool_slab_size);
+    return st;
+  }
+
+} // namespace casadi
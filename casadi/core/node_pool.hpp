@@ -0,0 +1,68 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_NODE_POOL_HPP
+#define CASADI_NODE_POOL_HPP
+
+#include "casadi_common.hpp"
+#include "generic_type.hpp"
+
+/// \cond INTERNAL
+namespace casadi {
+
+  /** \brief Slab allocator for expression graph nodes
+
+      Objects of up to 256 bytes are served from 64 KiB slabs, with one free
+      list per 16-byte size class. A slab is returned to the system as soon as
+      its last object is freed, so tearing down a graph releases its memory in
+      bulk instead of leaving a fragmented heap. Larger objects fall back to
+      the global operator new.
+
+      Enabled with the WITH_NODE_POOL build option, SXNode and MXNode then
+      route their class-specific operator new and delete through this class.
+  */
+  class CASADI_EXPORT NodePool {
+    private:
+      /// No instances are allowed
+      NodePool();
+    public:
+      /// Allocate an object of size sz
+      static void* allocate(size_t sz);
+
+      /// Free an object of size sz allocated with allocate
+      static void deallocate(void* p, size_t sz);
+
+      /** \brief Memory statistics
+
+          Entries "n_live" (pooled objects in use), "n_slab" (slabs held) and
+          "bytes" (memory held by slabs).
+      */
+      static Dict stats();
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_NODE_POOL_HPP
@@ -168,6 +168,26 @@ OptiSol Opti::solve_limited() {
   }
 }
 
+std::vector<double> Opti::resolve(const std::vector<double>& p, bool accept_limit) {
+  try {
+    casadi_assert(p.size()==(*this)->np(),
+      "Expected " + str((*this)->np()) + " parameter values, got " + str(p.size()) + ".");
+    std::vector<double> x((*this)->nx());
+    (*this)->resolve(get_ptr(p), get_ptr(x), accept_limit);
+    return x;
+  } catch (exception& e) {
+    THROW_ERROR("resolve", e.what());
+  }
+}
+
+void Opti::resolve(const double* p, double* x, bool accept_limit) {
+  try {
+    (*this)->resolve(p, x, accept_limit);
+  } catch (exception& e) {
+    THROW_ERROR("resolve", e.what());
+  }
+}
+
 DM Opti::value(const MX& x, const std::vector<MX>& values) const {
   try {
     return (*this)->value(x, values);
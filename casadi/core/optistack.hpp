@@ -166,6 +166,10 @@ public:
   *            In practice, not all nlpsol plugins may be supported yet
   * \param[in] options passed on to nlpsol plugin
   *            No stability can be guaranteed about this part of the API
+  *            Exception: "incremental_bake" (bool, default false) is handled by Opti.
+  *            It freezes the objective and constraints of nlp problems into
+  *            non-inlined block Functions, which are reused, together with their
+  *            derivatives, when a later solve only appends constraints or variables.
   * \param[in] options to be passed to nlpsol solver
   *            No stability can be guaranteed about this part of the API
   */
@@ -203,6 +207,25 @@ public:
    */
   OptiSol solve_limited();
 
+  /// @{
+  /** \brief Re-solve for new parameter values
+   *
+   * Fast path for solving the same problem repeatedly with varying parameters,
+   * e.g. in a control loop. p holds the values of all parameters that appear
+   * in the problem, ordered as in opti.p. Returns the solution, ordered as in opti.x.
+   *
+   * The first call, and the first call after the problem or solver changed,
+   * performs a regular solve. Subsequent calls are warm-started from the
+   * primal and dual solution of the previous call (values set with
+   * set_initial are not used) and work on preallocated buffers.
+   * value, stats, etc. remain available afterwards, as after solve.
+   */
+  std::vector<double> resolve(const std::vector<double>& p, bool accept_limit=false);
+#ifndef SWIG
+  void resolve(const double* p, double* x, bool accept_limit=false);
+#endif // SWIG
+  /// @}
+
   /// @{
   /** Obtain value of expression at the current value
   *
@@ -23,7 +23,7 @@
  */
 
 #include "optistack_internal.hpp"
-#include "nlpsol.hpp"
+#include "nlpsol_impl.hpp"
 #include "conic.hpp"
 #include "function_internal.hpp"
 #include "global_options.hpp"
@@ -242,6 +242,7 @@ MX OptiNode::g_lookup(casadi_int i) const {
 OptiNode::OptiNode(const std::string& problem_type) :
     count_(0), count_var_(0), count_par_(0), count_dual_(0) {
   f_ = 0;
+  incremental_bake_ = false;
   instance_number_ = instance_count_++;
   user_callback_ = nullptr;
   store_initial_[OPTI_VAR] = {};
@@ -643,9 +644,13 @@ void OptiNode::bake() {
     }
   }
 
-  nlp_["g"] = veccat(g_all);
   if (problem_type_=="conic") {
+    nlp_["g"] = veccat(g_all);
     nlp_["h"] = diagcat(h_all);
+  } else if (incremental_bake_) {
+    bake_blocks(x, p, g_all);
+  } else {
+    nlp_["g"] = veccat(g_all);
   }
 
   // Create bounds helper function
@@ -654,17 +659,100 @@ void OptiNode::bake() {
   bounds_lbg_ = veccat(lbg_all);
   bounds_ubg_ = veccat(ubg_all);
 
-  bounds["lbg"] = bounds_lbg_;
-  bounds["ubg"] = bounds_ubg_;
+  bounds["lbg"] = densify(bounds_lbg_);
+  bounds["ubg"] = densify(bounds_ubg_);
 
   bounds_ = Function("bounds", bounds, {"p"}, {"lbg", "ubg"});
   mark_problem_dirty(false);
 }
 
+void OptiNode::bake_blocks(const std::vector<MX>& x, const std::vector<MX>& p,
+    const std::vector<MX>& g_all) {
+  // Blocks remain usable if variables and parameters were only appended
+  bool extended = x.size()>=baked_x_.size() && p.size()>=baked_p_.size();
+  for (casadi_int i=0; extended && i<baked_x_.size(); ++i)
+    extended = x[i].get()==baked_x_[i].get();
+  for (casadi_int i=0; extended && i<baked_p_.size(); ++i)
+    extended = p[i].get()==baked_p_[i].get();
+  baked_x_ = x;
+  baked_p_ = p;
+
+  // Objective
+  if (!extended || f_block_.expr.empty() || f_block_.expr[0].get()!=f_.get()) {
+    f_block_ = bake_block("f", {f_}, x, p);
+  }
+  nlp_["f"] = call_block(f_block_, x, p);
+
+  // Keep the leading constraint blocks that are unchanged
+  casadi_int n_keep = 0, n_canon = 0;
+  if (extended) {
+    for (const BakedBlock& b : g_blocks_) {
+      if (n_canon+b.expr.size()>g_all.size()) break;
+      bool same = true;
+      for (casadi_int i=0; same && i<b.expr.size(); ++i)
+        same = b.expr[i].get()==g_all[n_canon+i].get();
+      if (!same) break;
+      n_keep++;
+      n_canon += b.expr.size();
+    }
+  }
+
+  // Too fragmented: start over with a single block
+  if (n_keep>=max_g_blocks_) n_keep = n_canon = 0;
+  g_blocks_.resize(n_keep);
+
+  // Remaining constraints form a new block
+  if (n_canon<g_all.size()) {
+    g_blocks_.push_back(bake_block("g_" + str(n_keep),
+      std::vector<MX>(g_all.begin()+n_canon, g_all.end()), x, p));
+  }
+
+  std::vector<MX> g;
+  for (const BakedBlock& b : g_blocks_) g.push_back(call_block(b, x, p));
+  nlp_["g"] = veccat(g);
+}
+
+OptiNode::BakedBlock OptiNode::bake_block(const std::string& name,
+    const std::vector<MX>& expr, const std::vector<MX>& x, const std::vector<MX>& p) const {
+  BakedBlock b;
+  b.expr = expr;
+  b.n_x = x.size();
+  b.n_p = p.size();
+  // Derivatives are not inlined, so that they can be reused from the cache
+  Dict der_opts = {{"never_inline", true}};
+  Dict opts = {{"never_inline", true},
+               {"forward_options", der_opts}, {"reverse_options", der_opts}};
+  b.fcn = Function(name_prefix() + name, {veccat(x), veccat(p)}, {veccat(expr)},
+    {"x", "p"}, {name}, opts);
+  return b;
+}
+
+MX OptiNode::call_block(const BakedBlock& b,
+    const std::vector<MX>& x, const std::vector<MX>& p) const {
+  std::vector<MX> x_b(x.begin(), x.begin()+b.n_x), p_b(p.begin(), p.begin()+b.n_p);
+  return b.fcn(std::vector<MX>{veccat(x_b), veccat(p_b)}).at(0);
+}
+
 void OptiNode::solver(const std::string& solver_name, const Dict& plugin_options,
                        const Dict& solver_options) {
   solver_name_ = solver_name;
   solver_options_ = plugin_options;
+  // Handled by Opti, not passed on to the solver
+  bool incremental_bake = false;
+  auto it = solver_options_.find("incremental_bake");
+  if (it!=solver_options_.end()) {
+    incremental_bake = it->second;
+    solver_options_.erase(it);
+  }
+  if (incremental_bake!=incremental_bake_) {
+    incremental_bake_ = incremental_bake;
+    // Drop the blocks of earlier bakes
+    f_block_ = BakedBlock();
+    g_blocks_.clear();
+    baked_x_.clear();
+    baked_p_.clear();
+    mark_problem_dirty();
+  }
   if (!solver_options.empty())
     solver_options_[solver_name] = solver_options;
   mark_solver_dirty();
@@ -942,6 +1030,7 @@ void OptiNode::res(const DMDict& res) {
     }
   }
   res_ = res;
+  resolve_.valid = false;
   mark_solved();
 }
 
@@ -1043,6 +1132,162 @@ DMDict OptiNode::solve_actual(const DMDict& arg) {
   return solver_(arg);
 }
 
+void OptiNode::resolve_init() {
+  ResolveCache& c = resolve_;
+  const Function& s = solver_;
+
+  // Flat copies of the arguments and results of the latest solve
+  c.in.resize(s.n_in());
+  for (casadi_int i=0;i<s.n_in();++i) {
+    c.in[i].assign(s.nnz_in(i), s.default_in(i));
+    auto it = arg_.find(s.name_in(i));
+    if (it!=arg_.end() && it->second.nnz()==s.nnz_in(i))
+      std::copy(it->second->begin(), it->second->end(), c.in[i].begin());
+  }
+  c.out.resize(s.n_out());
+  for (casadi_int i=0;i<s.n_out();++i) {
+    c.out[i].assign(s.nnz_out(i), 0);
+    auto it = res_.find(s.name_out(i));
+    if (it!=res_.end() && it->second.nnz()==s.nnz_out(i))
+      std::copy(it->second->begin(), it->second->end(), c.out[i].begin());
+  }
+
+  // Locate the entries that are updated between calls
+  auto index = [](const std::vector<std::string>& names, const std::string& n) {
+    auto it = std::find(names.begin(), names.end(), n);
+    return it==names.end() ? -1 : static_cast<casadi_int>(it-names.begin());
+  };
+  std::vector<std::string> name_in = s.name_in(), name_out = s.name_out();
+  c.i_x0 = index(name_in, "x0");
+  c.i_p = index(name_in, "p");
+  c.i_lbg = index(name_in, "lbg");
+  c.i_ubg = index(name_in, "ubg");
+  c.i_lam_x0 = index(name_in, "lam_x0");
+  c.i_lam_g0 = index(name_in, "lam_g0");
+  c.o_x = index(name_out, "x");
+  c.o_lam_x = index(name_out, "lam_x");
+  c.o_lam_g = index(name_out, "lam_g");
+  casadi_assert_dev(c.i_x0>=0 && c.i_p>=0 && c.i_lbg>=0 && c.i_ubg>=0 && c.o_x>=0);
+
+  // Work vectors, shared by the solver and the bounds helper
+  c.arg.resize(std::max(s.sz_arg(), bounds_.sz_arg()));
+  c.res.resize(std::max(s.sz_res(), bounds_.sz_res()));
+  c.iw.resize(std::max(s.sz_iw(), bounds_.sz_iw()));
+  c.w.resize(std::max(s.sz_w(), bounds_.sz_w()));
+
+  // Where active symbols live in the store and in the flat vectors
+  c.var.clear();
+  for (const auto& v : active_symvar(OPTI_VAR))
+    c.var.push_back({{meta(v).i, meta(v).start, meta(v).stop-meta(v).start}});
+  c.dual.clear();
+  if (problem_type_!="conic" && c.o_lam_g>=0) {
+    for (const auto& v : active_symvar(OPTI_DUAL_G))
+      c.dual.push_back({{meta(v).i, meta(v).start, meta(v).stop-meta(v).start}});
+  }
+  c.par.clear();
+  casadi_int offset = 0;
+  for (const auto& v : active_symvar(OPTI_PAR)) {
+    c.par.push_back({{meta(v).i, offset, v.nnz()}});
+    offset += v.nnz();
+  }
+  casadi_assert_dev(offset==c.in[c.i_p].size());
+
+  c.valid = true;
+}
+
+void OptiNode::resolve(const double* p, double* x, bool accept_limit) {
+  if (problem_dirty()) bake();
+  ResolveCache& c = resolve_;
+
+  if (!c.valid || solver_dirty() || old_callback() || (user_callback_ && callback_.is_null())) {
+    // Regular solve, after which the buffers are in place
+    casadi_int offset = 0;
+    for (const auto& v : active_symvar(OPTI_PAR)) {
+      std::vector<double>& data_v = store_initial_[OPTI_PAR][meta(v).i].nonzeros();
+      std::copy(p+offset, p+offset+data_v.size(), data_v.begin());
+      offset += data_v.size();
+    }
+    solve(accept_limit);
+    resolve_init();
+  } else {
+    std::vector<double>& p_v = c.in[c.i_p];
+    for (casadi_int k=0;k<p_v.size();++k) {
+      casadi_assert(std::isfinite(p[k]),
+        "Parameter value " + str(k) + " passed to 'resolve' is NaN/Inf.");
+    }
+    std::copy(p, p+p_v.size(), p_v.begin());
+
+    // Evaluate bounds for given parameter values
+    c.arg[0] = get_ptr(p_v);
+    c.res[0] = get_ptr(c.in[c.i_lbg]);
+    c.res[1] = get_ptr(c.in[c.i_ubg]);
+    bounds_(get_ptr(c.arg), get_ptr(c.res), get_ptr(c.iw), get_ptr(c.w));
+
+    // Warm start from the latest solution
+    std::copy(c.out[c.o_x].begin(), c.out[c.o_x].end(), c.in[c.i_x0].begin());
+    if (c.i_lam_x0>=0 && c.o_lam_x>=0)
+      std::copy(c.out[c.o_lam_x].begin(), c.out[c.o_lam_x].end(), c.in[c.i_lam_x0].begin());
+    if (c.i_lam_g0>=0 && c.o_lam_g>=0)
+      std::copy(c.out[c.o_lam_g].begin(), c.out[c.o_lam_g].end(), c.in[c.i_lam_g0].begin());
+
+    if (user_callback_) {
+      InternalOptiCallback* cb = static_cast<InternalOptiCallback*>(callback_.get());
+      cb->reset();
+    }
+
+    // Call the solver on the flat buffers
+    for (casadi_int i=0;i<c.in.size();++i) c.arg[i] = get_ptr(c.in[i]);
+    for (casadi_int i=0;i<c.out.size();++i) c.res[i] = get_ptr(c.out[i]);
+    bool success = false;
+    const Nlpsol* nlpsol = dynamic_cast<const Nlpsol*>(solver_.get());
+    int mem = solver_.checkout();
+    try {
+      solver_(get_ptr(c.arg), get_ptr(c.res), get_ptr(c.iw), get_ptr(c.w), mem);
+      if (nlpsol) {
+        const NlpsolMemory* m = static_cast<const NlpsolMemory*>(solver_.memory(mem));
+        success = m->success || (accept_limit &&
+          m->unified_return_status==FunctionInternal::SOLVER_RET_LIMITED);
+      }
+    } catch (...) {
+      solver_.release(mem);
+      throw;
+    }
+    solver_.release(mem);
+
+    // Keep the Opti state in line with a regular solve
+    for (const auto& e : c.par) {
+      std::copy(p_v.begin()+e[1], p_v.begin()+e[1]+e[2],
+        store_initial_[OPTI_PAR][e[0]]->begin());
+    }
+    for (const auto& e : c.var) {
+      std::copy(c.out[c.o_x].begin()+e[1], c.out[c.o_x].begin()+e[1]+e[2],
+        store_latest_[OPTI_VAR][e[0]]->begin());
+    }
+    for (const auto& e : c.dual) {
+      std::copy(c.out[c.o_lam_g].begin()+e[1], c.out[c.o_lam_g].begin()+e[1]+e[2],
+        store_latest_[OPTI_DUAL_G][e[0]]->begin());
+    }
+    for (casadi_int i=0;i<c.in.size();++i) {
+      auto it = arg_.find(solver_.name_in(i));
+      if (it!=arg_.end() && it->second.nnz()==c.in[i].size())
+        std::copy(c.in[i].begin(), c.in[i].end(), it->second->begin());
+    }
+    for (casadi_int i=0;i<c.out.size();++i) {
+      auto it = res_.find(solver_.name_out(i));
+      if (it!=res_.end() && it->second.nnz()==c.out[i].size())
+        std::copy(c.out[i].begin(), c.out[i].end(), it->second->begin());
+    }
+    mark_solved();
+
+    if (!nlpsol) success = return_success(accept_limit);
+    casadi_assert(success,
+      "Solver failed. You may use opti.debug.value to investigate the latest values of variables."
+      " return_status is '" + return_status() + "'");
+  }
+
+  std::copy(c.out[c.o_x].begin(), c.out[c.o_x].end(), x);
+}
+
 bool override_num(const std::map<casadi_int, MX> & temp, std::vector<DM>& num, casadi_int i) {
   // Override when values are supplied
   auto it = temp.find(i);
@@ -27,6 +27,7 @@
 
 #include "optistack.hpp"
 #include "shared_object_internal.hpp"
+#include <array>
 
 namespace casadi {
 
@@ -99,6 +100,9 @@ public:
   /// Crunch the numbers; solve the problem
   OptiSol solve(bool accept_limit);
 
+  /// Re-solve for new parameter values, warm-started from the latest solution
+  void resolve(const double* p, double* x, bool accept_limit);
+
   /// @{
   /// Obtain value of expression at the current value
   DM value(const MX& x, const std::vector<MX>& values=std::vector<MX>()) const;
@@ -366,9 +370,76 @@ private:
   MX bounds_lbg_;
   MX bounds_ubg_;
 
+  /** \brief Preallocated state for resolve
+   *
+   * Holds every solver input and output as a flat buffer, together with the
+   * work vectors of the solver and bounds_, so that a re-solve with new
+   * parameter values bypasses the DM/Dict machinery of solve.
+   * Set up after a regular solve; reset whenever res_ is replaced.
+   */
+  struct ResolveCache {
+    bool valid;
+    /// Solver inputs and outputs
+    std::vector< std::vector<double> > in, out;
+    /// Input and output indices of the solver
+    casadi_int i_x0, i_p, i_lbg, i_ubg, i_lam_x0, i_lam_g0;
+    casadi_int o_x, o_lam_x, o_lam_g;
+    /// Work vectors
+    std::vector<const double*> arg;
+    std::vector<double*> res;
+    std::vector<casadi_int> iw;
+    std::vector<double> w;
+    /// Store index, offset and number of nonzeros of active symbols
+    std::vector< std::array<casadi_int, 3> > var, par, dual;
+    ResolveCache() : valid(false) {}
+  };
+  ResolveCache resolve_;
+
+  /// Set up resolve_ from the latest solve
+  void resolve_init();
+
   /// Constraints verbatim as passed in with 'subject_to'
   std::vector<MX> g_;
 
+  /** \brief Part of the NLP frozen into a Function by an earlier bake
+   *
+   * While the problem is only extended (constraints, variables and parameters
+   * appended), bake reuses the blocks of earlier bakes. Derivative functions that
+   * a solver generates for a block are cached in the block, and hence reused by
+   * the solver of the next bake instead of being regenerated.
+   */
+  struct BakedBlock {
+    Function fcn;
+    /// Expressions covered
+    std::vector<MX> expr;
+    /// Number of leading active variables and parameters used
+    casadi_int n_x, n_p;
+  };
+
+  /// Bake nlp problems into blocks, plugin option "incremental_bake"
+  bool incremental_bake_;
+
+  /// Objective and constraint blocks
+  BakedBlock f_block_;
+  std::vector<BakedBlock> g_blocks_;
+
+  /// Active variables and parameters of the last bake
+  std::vector<MX> baked_x_, baked_p_;
+
+  /// Maximum number of constraint blocks before they are merged
+  static const casadi_int max_g_blocks_ = 8;
+
+  /// Set nlp_["f"] and nlp_["g"], reusing the blocks of earlier bakes where possible
+  void bake_blocks(const std::vector<MX>& x, const std::vector<MX>& p,
+    const std::vector<MX>& g_all);
+
+  /// Freeze expressions into a block
+  BakedBlock bake_block(const std::string& name, const std::vector<MX>& expr,
+    const std::vector<MX>& x, const std::vector<MX>& p) const;
+
+  /// Expression for a block
+  MX call_block(const BakedBlock& b, const std::vector<MX>& x, const std::vector<MX>& p) const;
+
   /// Objective verbatim as passed in with 'minimize'
   MX f_;
 
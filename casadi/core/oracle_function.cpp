@@ -153,20 +153,42 @@ namespace casadi {
     return ret;
   }
 
-  void OracleFunction::
+  casadi_int OracleFunction::
   set_function(const Function& fcn, const std::string& fname, bool jit) {
     casadi_assert(!has_function(fname), "Duplicate function " + fname);
-    RegFun& r = all_functions_[fname];
+    auto it = all_functions_.insert(std::make_pair(fname, RegFun())).first;
+    RegFun& r = it->second;
     r.f = fcn;
     r.jit = jit;
     alloc(fcn);
+    fcn_.push_back(it);
+    return fcn_.size()-1;
+  }
+
+  casadi_int OracleFunction::function_index(const std::string& fname) const {
+    for (casadi_int i=0; i<fcn_.size(); ++i) {
+      if (fcn_[i]->first==fname) return i;
+    }
+    casadi_error("No function \"" + fname + "\" in " + name_ + ". " +
+      "Available functions: " + join(get_function()) + ".");
+    return -1;
   }
 
   int OracleFunction::
   calc_function(OracleMemory* m, const std::string& fcn,
                 const double* const* arg) const {
+    return calc_function(m, function_index(fcn), arg);
+  }
+
+  int OracleFunction::
+  calc_function(OracleMemory* m, casadi_int ind,
+                const double* const* arg) const {
+    // Registered function
+    const std::string& fcn = fcn_[ind]->first;
+    const RegFun& r = fcn_[ind]->second;
+
     // Is the function monitored?
-    bool monitored = this->monitored(fcn);
+    bool monitored = r.monitored;
 
     // Print progress
     if (monitored) casadi_message("Calling \"" + fcn + "\"");
@@ -175,10 +197,10 @@ namespace casadi {
     InterruptHandler::check();
 
     // Get function
-    const Function& f = get_function(fcn);
+    const Function& f = r.f;
 
     // Get statistics structure
-    FStats& fstats = m->fstats.at(fcn);
+    FStats& fstats = *m->fcn_stats[ind];
 
     // Number of inputs and outputs
     casadi_int n_in = f.n_in(), n_out = f.n_out();
@@ -318,6 +340,12 @@ namespace casadi {
     for (auto&& e : all_functions_) {
       m->add_stat(e.first);
     }
+
+    // Flat access by function handle
+    m->fcn_stats.resize(fcn_.size());
+    for (casadi_int i=0; i<fcn_.size(); ++i) {
+      m->fcn_stats[i] = &m->fstats.at(fcn_[i]->first);
+    }
     return 0;
   }
 
@@ -423,7 +451,7 @@ namespace casadi {
         }
       }
       s.unpack("OracleFunction::all_functions::value::monitored", r.monitored);
-      all_functions_[key] = r;
+      fcn_.push_back(all_functions_.insert(std::make_pair(key, r)).first);
     }
     s.unpack("OracleFunction::monitor", monitor_);
   }
@@ -38,6 +38,9 @@ namespace casadi {
     double** res;
     casadi_int* iw;
     double* w;
+
+    // Statistics of the registered functions, indexed by function handle
+    std::vector<FStats*> fcn_stats;
   };
 
   /** \brief Base class for functions that perform calculation with an oracle
@@ -67,6 +70,9 @@ namespace casadi {
     // All NLP functions
     std::map<std::string, RegFun> all_functions_;
 
+    // Registered functions, indexed by function handle
+    std::vector<std::map<std::string, RegFun>::iterator> fcn_;
+
     // Active monitors
     std::vector<std::string> monitor_;
 
@@ -102,16 +108,23 @@ namespace casadi {
                     const std::vector<std::string>& s_out,
                     const Function::AuxOut& aux=Function::AuxOut());
 
-    /** Register the function for evaluation and statistics gathering */
-    void set_function(const Function& fcn, const std::string& fname, bool jit=false);
+    /** Register the function for evaluation and statistics gathering, returns a handle */
+    casadi_int set_function(const Function& fcn, const std::string& fname, bool jit=false);
+
+    /** Register the function for evaluation and statistics gathering, returns a handle */
+    casadi_int set_function(const Function& fcn) { return set_function(fcn, fcn.name()); }
 
-    /** Register the function for evaluation and statistics gathering */
-    void set_function(const Function& fcn) { set_function(fcn, fcn.name()); }
+    /** Get the handle of a registered function */
+    casadi_int function_index(const std::string& fname) const;
 
     // Calculate an oracle function
     int calc_function(OracleMemory* m, const std::string& fcn,
                       const double* const* arg=nullptr) const;
 
+    // Calculate an oracle function, given its handle
+    int calc_function(OracleMemory* m, casadi_int ind,
+                      const double* const* arg=nullptr) const;
+
     /** \brief Get list of dependency functions
      * -1 Indicates irregularity
     */
@@ -0,0 +1,314 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#include "packed_tape.hpp"
+#include "sx_function.hpp"
+#include "serializing_stream.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace casadi {
+
+  namespace {
+
+    // Approximate size of a tape chunk, the unit of prefetching
+    const size_t tape_chunk_size = 1 << 20;
+
+    // Flag in the operation code byte, set for binary operations
+    const unsigned char tape_binary = 0x80;
+
+    // Variable length encoding of unsigned integers, 7 bits per byte
+    inline void put_uint(std::vector<unsigned char>& v, uint64_t x) {
+      while (x>=0x80) {
+        v.push_back(static_cast<unsigned char>(x | 0x80));
+        x >>= 7;
+      }
+      v.push_back(static_cast<unsigned char>(x));
+    }
+
+    // Signed integers, zigzag mapped so that small magnitudes are short
+    inline void put_int(std::vector<unsigned char>& v, int64_t x) {
+      put_uint(v, (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63));
+    }
+
+    inline uint64_t get_uint(const unsigned char*& p) {
+      uint64_t x = 0;
+      int s = 0;
+      while (*p & 0x80) {
+        x |= static_cast<uint64_t>(*p++ & 0x7f) << s;
+        s += 7;
+      }
+      return x | (static_cast<uint64_t>(*p++) << s);
+    }
+
+    inline int64_t get_int(const unsigned char*& p) {
+      uint64_t x = get_uint(p);
+      return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+    }
+
+    // Raw fixed size integers, for the chunk table at the end of the file
+    inline void put_raw(std::ostream& out, uint64_t x) {
+      out.write(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+
+    inline uint64_t get_raw(const unsigned char* p) {
+      uint64_t x;
+      std::memcpy(&x, p, sizeof(x));
+      return x;
+    }
+
+  } // namespace
+
+  void PackedTape::save(const SXFunction& f, const std::string& fname) {
+    casadi_assert(f.free_vars_.empty(),
+                  "Cannot save the tape since variables " + str(f.free_vars_) + " are free.");
+    std::ofstream out(fname, std::ios::binary);
+    casadi_assert(out.good(), "Cannot open \"" + fname + "\" for writing");
+
+    // Header: everything needed to construct the Function
+    {
+      SerializingStream s(out);
+      s.version("PackedTape", 1);
+      s.pack("PackedTape::sp_in", f.sparsity_in_);
+      s.pack("PackedTape::sp_out", f.sparsity_out_);
+      s.pack("PackedTape::names_in", f.name_in_);
+      s.pack("PackedTape::names_out", f.name_out_);
+      s.pack("PackedTape::worksize", static_cast<casadi_int>(f.worksize_));
+      s.pack("PackedTape::n_instr", static_cast<casadi_int>(f.algorithm_.size()));
+    }
+    uint64_t tape_start = out.tellp();
+
+    // Tape, written chunk by chunk. Indices are coded relative to the previous
+    // destination, which restarts at each chunk so that chunks decode independently.
+    std::vector<uint64_t> chunk_offset(1, 0);
+    std::vector<unsigned char> chunk;
+    chunk.reserve(tape_chunk_size + 32);
+    int prev = 0;
+    for (auto&& e : f.algorithm_) {
+      casadi_assert_dev(e.op>=0 && e.op<tape_binary);
+      switch (e.op) {
+      case OP_CONST:
+        chunk.push_back(static_cast<unsigned char>(e.op));
+        put_int(chunk, e.i0 - prev);
+        chunk.insert(chunk.end(), reinterpret_cast<const unsigned char*>(&e.d),
+                     reinterpret_cast<const unsigned char*>(&e.d) + sizeof(double));
+        prev = e.i0;
+        break;
+      case OP_INPUT:
+        chunk.push_back(static_cast<unsigned char>(e.op));
+        put_int(chunk, e.i0 - prev);
+        put_uint(chunk, e.i1);
+        put_uint(chunk, e.i2);
+        prev = e.i0;
+        break;
+      case OP_OUTPUT:
+        chunk.push_back(static_cast<unsigned char>(e.op));
+        put_uint(chunk, e.i0);
+        put_int(chunk, e.i1 - prev);
+        put_uint(chunk, e.i2);
+        break;
+      default:
+        if (casadi_math<double>::ndeps(e.op)==2) {
+          chunk.push_back(static_cast<unsigned char>(e.op) | tape_binary);
+          put_int(chunk, e.i0 - prev);
+          put_int(chunk, e.i1 - e.i0);
+          put_int(chunk, e.i2 - e.i0);
+        } else {
+          chunk.push_back(static_cast<unsigned char>(e.op));
+          put_int(chunk, e.i0 - prev);
+          put_int(chunk, e.i1 - e.i0);
+        }
+        prev = e.i0;
+      }
+      if (chunk.size()>=tape_chunk_size) {
+        out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        chunk_offset.push_back(chunk_offset.back() + chunk.size());
+        chunk.clear();
+        prev = 0;
+      }
+    }
+    if (!chunk.empty()) {
+      out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+      chunk_offset.push_back(chunk_offset.back() + chunk.size());
+    }
+
+    // Trailer: chunk offsets, their number and the start of the tape
+    for (uint64_t c : chunk_offset) put_raw(out, c);
+    put_raw(out, chunk_offset.size());
+    put_raw(out, tape_start);
+    casadi_assert(out.good(), "Failed to write \"" + fname + "\"");
+  }
+
+  PackedTape::PackedTape(const std::string& name, const std::string& fname)
+    : FunctionInternal(name), fname_(fname), map_(nullptr), map_size_(0), tape_(nullptr) {
+    // Header
+    {
+      std::ifstream in(fname, std::ios::binary);
+      casadi_assert(in.good(), "Cannot open \"" + fname + "\"");
+      DeserializingStream s(in);
+      s.version("PackedTape", 1);
+      s.unpack("PackedTape::sp_in", sp_in_);
+      s.unpack("PackedTape::sp_out", sp_out_);
+      s.unpack("PackedTape::names_in", names_in_);
+      s.unpack("PackedTape::names_out", names_out_);
+      s.unpack("PackedTape::worksize", worksize_);
+      s.unpack("PackedTape::n_instr", n_instr_);
+    }
+
+    // Map the whole file, pages of the tape are only read when evaluated
+#ifdef _WIN32
+    // No memory mapping, read the file instead
+    std::ifstream in(fname, std::ios::binary | std::ios::ate);
+    map_size_ = in.tellg();
+    in.seekg(0);
+    map_ = new char[map_size_];
+    in.read(static_cast<char*>(map_), map_size_);
+    casadi_assert(in.good(), "Failed to read \"" + fname + "\"");
+#else // _WIN32
+    int fd = open(fname.c_str(), O_RDONLY);
+    casadi_assert(fd>=0, "Cannot open \"" + fname + "\"");
+    struct stat st;
+    if (fstat(fd, &st)!=0) {
+      close(fd);
+      casadi_error("Cannot stat \"" + fname + "\"");
+    }
+    map_size_ = st.st_size;
+    void* m = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    casadi_assert(m!=MAP_FAILED, "Cannot map \"" + fname + "\"");
+    map_ = m;
+    madvise(map_, map_size_, MADV_SEQUENTIAL);
+#endif // _WIN32
+
+    // Trailer
+    const unsigned char* base = static_cast<const unsigned char*>(map_);
+    casadi_assert(map_size_>=2*sizeof(uint64_t), "Corrupt tape \"" + fname + "\"");
+    uint64_t n_offset = get_raw(base + map_size_ - 2*sizeof(uint64_t));
+    uint64_t tape_start = get_raw(base + map_size_ - sizeof(uint64_t));
+    casadi_assert(n_offset>=1 && (n_offset+2)*sizeof(uint64_t)<=map_size_,
+                  "Corrupt tape \"" + fname + "\"");
+    const unsigned char* p = base + map_size_ - (n_offset+2)*sizeof(uint64_t);
+    chunk_offset_.resize(n_offset);
+    for (auto&& c : chunk_offset_) {
+      c = get_raw(p);
+      p += sizeof(uint64_t);
+    }
+    casadi_assert(tape_start + chunk_offset_.back()
+                  + (n_offset+2)*sizeof(uint64_t)==map_size_,
+                  "Corrupt tape \"" + fname + "\"");
+    tape_ = base + tape_start;
+  }
+
+  PackedTape::~PackedTape() {
+    clear_mem();
+#ifdef _WIN32
+    delete[] static_cast<char*>(map_);
+#else // _WIN32
+    if (map_) munmap(map_, map_size_);
+#endif // _WIN32
+  }
+
+  void PackedTape::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // Allocate work vector
+    alloc_w(worksize_, true);
+  }
+
+  int PackedTape::eval(const double** arg, double** res,
+                       casadi_int* iw, double* w, void* mem) const {
+    casadi_int n_chunk = chunk_offset_.size() - 1;
+    for (casadi_int c=0; c<n_chunk; ++c) {
+      const unsigned char* p = tape_ + chunk_offset_[c];
+      const unsigned char* end = tape_ + chunk_offset_[c+1];
+#ifndef _WIN32
+      // Ask for the next chunk to be read in while this one is evaluated
+      if (c+1<n_chunk) {
+        size_t page = sysconf(_SC_PAGESIZE);
+        uintptr_t a = reinterpret_cast<uintptr_t>(end) & ~static_cast<uintptr_t>(page-1);
+        uintptr_t b = reinterpret_cast<uintptr_t>(tape_ + chunk_offset_[c+2]);
+        madvise(reinterpret_cast<void*>(a), b-a, MADV_WILLNEED);
+      }
+#endif // _WIN32
+      int i0 = 0, i1, i2;
+      while (p<end) {
+        unsigned char op = *p++;
+        if (op & tape_binary) {
+          i0 += static_cast<int>(get_int(p));
+          i1 = i0 + static_cast<int>(get_int(p));
+          i2 = i0 + static_cast<int>(get_int(p));
+          switch (op & ~tape_binary) {
+            CASADI_MATH_FUN_BUILTIN(w[i1], w[i2], w[i0])
+          default:
+            casadi_error("Unknown operation" + str(op & ~tape_binary));
+          }
+          continue;
+        }
+        switch (op) {
+        case OP_CONST:
+          i0 += static_cast<int>(get_int(p));
+          std::memcpy(w + i0, p, sizeof(double));
+          p += sizeof(double);
+          break;
+        case OP_INPUT:
+          {
+            i0 += static_cast<int>(get_int(p));
+            casadi_int ind = get_uint(p), nz = get_uint(p);
+            w[i0] = arg[ind]==nullptr ? 0 : arg[ind][nz];
+          }
+          break;
+        case OP_OUTPUT:
+          {
+            casadi_int ind = get_uint(p);
+            i1 = i0 + static_cast<int>(get_int(p));
+            casadi_int nz = get_uint(p);
+            if (res[ind]!=nullptr) res[ind][nz] = w[i1];
+          }
+          break;
+        default:
+          i0 += static_cast<int>(get_int(p));
+          i1 = i0 + static_cast<int>(get_int(p));
+          switch (op) {
+            CASADI_MATH_FUN_BUILTIN(w[i1], w[i1], w[i0])
+          default:
+            casadi_error("Unknown operation" + str(op));
+          }
+        }
+      }
+    }
+    return 0;
+  }
+
+} // namespace casadi
@@ -0,0 +1,112 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef CASADI_PACKED_TAPE_HPP
+#define CASADI_PACKED_TAPE_HPP
+
+#include "function_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+  class SXFunction;
+
+  /** \brief Numerical evaluation of an SXFunction algorithm streamed from a file
+
+      The algorithm is stored packed: one byte per operation code and variable length,
+      delta-encoded work vector indices. The file is memory-mapped and evaluated chunk by
+      chunk, prefetching the next chunk, so that the operating system can keep only a
+      window of the tape resident. No expression graph is held in memory.
+      Only numerical evaluation is supported.
+  */
+  class CASADI_EXPORT PackedTape : public FunctionInternal {
+  public:
+    /** \brief Write the algorithm of an SXFunction to a file */
+    static void save(const SXFunction& f, const std::string& fname);
+
+    /** \brief Constructor, maps a file written with save */
+    PackedTape(const std::string& name, const std::string& fname);
+
+    /** \brief Destructor */
+    ~PackedTape() override;
+
+    /** \brief Get type name */
+    std::string class_name() const override {return "PackedTape";}
+
+    ///@{
+    /** \brief Number of function inputs and outputs */
+    size_t get_n_in() override { return sp_in_.size();}
+    size_t get_n_out() override { return sp_out_.size();}
+    ///@}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs */
+    Sparsity get_sparsity_in(casadi_int i) override { return sp_in_.at(i);}
+    Sparsity get_sparsity_out(casadi_int i) override { return sp_out_.at(i);}
+    /// @}
+
+    ///@{
+    /** \brief Names of function input and outputs */
+    std::string get_name_in(casadi_int i) override { return names_in_.at(i);}
+    std::string get_name_out(casadi_int i) override { return names_out_.at(i);}
+    ///@}
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    /** \brief  Evaluate numerically */
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+    /** \brief Size of the packed tape in bytes */
+    size_t tape_size() const { return chunk_offset_.back();}
+
+  private:
+    // File name
+    std::string fname_;
+
+    // Input and output sparsity patterns and names
+    std::vector<Sparsity> sp_in_, sp_out_;
+    std::vector<std::string> names_in_, names_out_;
+
+    // Work vector size
+    casadi_int worksize_;
+
+    // Number of instructions
+    casadi_int n_instr_;
+
+    // Offset of each chunk in the tape, followed by the end of the tape
+    std::vector<size_t> chunk_offset_;
+
+    // Mapping of the file and the start of the tape in it
+    void* map_;
+    size_t map_size_;
+    const unsigned char* tape_;
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_PACKED_TAPE_HPP
@@ -0,0 +1,364 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#include "profiler.hpp"
+#include "exception.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CASADI_PROFILER_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CASADI_PROFILER_RDTSC
+#endif
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif //CASADI_WITH_THREAD
+
+namespace casadi {
+
+  bool Profiler::active_ = false;
+
+  namespace {
+
+    // Node in the call tree
+    struct ProfilerNode {
+      std::string name;
+      std::string suffix;
+      casadi_int parent;
+      casadi_int n_call;
+      uint64_t t_inclusive;
+      uint64_t t_children;
+      std::vector<casadi_int> children;
+    };
+
+    // Completed call, for trace export
+    struct ProfilerEvent {
+      casadi_int node;
+      casadi_int tid;
+      uint64_t t_start;
+      uint64_t t_stop;
+      // Number of aggregated executions, zero for a scope
+      casadi_int n_call;
+    };
+
+    // Call stack of the current thread
+    struct ProfilerStack {
+      casadi_int session = -1;
+      casadi_int tid = 0;
+      std::vector<casadi_int> node;
+      std::vector<uint64_t> t_start;
+      // Aggregated time already laid out in the trace, per scope
+      std::vector<uint64_t> t_added;
+    };
+
+    // Global profiler state
+    struct ProfilerData {
+      std::vector<ProfilerNode> nodes;
+      std::vector<ProfilerEvent> events;
+      bool use_cycles = true;
+      bool trace = true;
+      casadi_int sample = 1;
+      casadi_int max_events = 1000000;
+      // Incremented on reset, invalidates per-thread stacks
+      casadi_int session = 0;
+      casadi_int n_threads = 0;
+#ifdef CASADI_WITH_THREAD
+      std::mutex mtx;
+#endif // CASADI_WITH_THREAD
+      ProfilerData() { clear(); }
+      void clear() {
+        nodes.clear();
+        events.clear();
+        nodes.push_back(ProfilerNode{"root", "", -1, 0, 0, 0, {}});
+        session++;
+      }
+    };
+
+    ProfilerData& profiler_data() {
+      static ProfilerData d;
+      return d;
+    }
+
+    thread_local ProfilerStack profiler_stack;
+
+    inline uint64_t profiler_tick(bool use_cycles) {
+#ifdef CASADI_PROFILER_RDTSC
+      if (use_cycles) return __rdtsc();
+#endif // CASADI_PROFILER_RDTSC
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Cycle counter frequency, measured once against the steady clock
+    double profiler_cycles_per_sec() {
+      static const double cycles_per_sec = [] {
+        auto w0 = std::chrono::steady_clock::now();
+        uint64_t t0 = profiler_tick(true);
+        double wall;
+        do {
+          wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+        } while (wall < 0.005);
+        return static_cast<double>(profiler_tick(true) - t0) / wall;
+      }();
+      return cycles_per_sec;
+    }
+
+    double profiler_ticks_per_sec(const ProfilerData& d) {
+      return d.use_cycles ? profiler_cycles_per_sec() : 1e9;
+    }
+
+    void profiler_stats(const ProfilerData& d, casadi_int k, Dict& st) {
+      const ProfilerNode& n = d.nodes[k];
+      uint64_t t_self = n.t_inclusive >= n.t_children ? n.t_inclusive - n.t_children : 0;
+      double ticks_per_sec = profiler_ticks_per_sec(d);
+      st["n_call"] = n.n_call;
+      st["t_inclusive"] = static_cast<double>(n.t_inclusive) / ticks_per_sec;
+      st["t_self"] = static_cast<double>(t_self) / ticks_per_sec;
+      Dict ch;
+      for (casadi_int c : n.children) {
+        Dict cst;
+        profiler_stats(d, c, cst);
+        ch[d.nodes[c].name + d.nodes[c].suffix] = cst;
+      }
+      st["children"] = ch;
+    }
+
+    void profiler_flamegraph(std::ostream& s, const ProfilerData& d, casadi_int k) {
+      const ProfilerNode& n = d.nodes[k];
+      s << "{\"name\": \"" << (n.name + n.suffix) << "\", \"value\": "
+        << static_cast<double>(n.t_inclusive) / profiler_ticks_per_sec(d) * 1e6
+        << ", \"n_call\": " << n.n_call << ", \"children\": [";
+      for (casadi_int i=0; i<n.children.size(); ++i) {
+        if (i>0) s << ", ";
+        profiler_flamegraph(s, d, n.children[i]);
+      }
+      s << "]}";
+    }
+
+    // Locate child, allocation-free unless new
+    casadi_int profiler_child(ProfilerData& d, casadi_int parent,
+        const std::string& name, const char* suffix) {
+      for (casadi_int c : d.nodes[parent].children) {
+        const ProfilerNode& n = d.nodes[c];
+        if (n.name==name && std::strcmp(n.suffix.c_str(), suffix)==0) return c;
+      }
+      casadi_int k = d.nodes.size();
+      d.nodes.push_back(ProfilerNode{name, suffix, parent, 0, 0, 0, {}});
+      d.nodes[parent].children.push_back(k);
+      return k;
+    }
+
+  } // namespace
+
+  void Profiler::start(const Dict& opts) {
+    ProfilerData& d = profiler_data();
+    if (active_) return;
+    for (auto&& op : opts) {
+      if (op.first=="clock") {
+        std::string clock = op.second;
+        casadi_assert(clock=="cycles" || clock=="steady",
+          "Profiler: 'clock' must be \"cycles\" or \"steady\", got \"" + clock + "\"");
+        bool use_cycles = clock=="cycles";
+#ifndef CASADI_PROFILER_RDTSC
+        use_cycles = false;
+#endif // CASADI_PROFILER_RDTSC
+        casadi_assert(use_cycles==d.use_cycles || d.nodes.size()==1,
+          "Profiler: cannot change 'clock' of recorded data, call reset first");
+        d.use_cycles = use_cycles;
+      } else if (op.first=="trace") {
+        d.trace = op.second;
+      } else if (op.first=="sample") {
+        d.sample = op.second;
+        casadi_assert(d.sample>=1, "Profiler: 'sample' must be positive");
+      } else if (op.first=="max_events") {
+        d.max_events = op.second;
+      } else {
+        casadi_error("Profiler: no such option: " + op.first + ". "
+          "Available options: clock, trace, sample, max_events");
+      }
+    }
+#ifndef CASADI_PROFILER_RDTSC
+    d.use_cycles = false;
+#endif // CASADI_PROFILER_RDTSC
+    // Calibrate before any timing
+    profiler_ticks_per_sec(d);
+    active_ = true;
+  }
+
+  void Profiler::stop() {
+    active_ = false;
+  }
+
+  void Profiler::reset() {
+    casadi_assert(!active_, "Profiler: stop profiling before calling reset");
+    profiler_data().clear();
+  }
+
+  bool Profiler::is_active() {
+    return active_;
+  }
+
+  void Profiler::enter(const std::string& name, const char* suffix) {
+    ProfilerData& d = profiler_data();
+    ProfilerStack& st = profiler_stack;
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    if (st.session!=d.session) {
+      // First call of this thread since the data was cleared
+      if (st.session<0) st.tid = d.n_threads++;
+      st.session = d.session;
+      st.node.clear();
+      st.t_start.clear();
+      st.t_added.clear();
+    }
+    casadi_int parent = st.node.empty() ? 0 : st.node.back();
+    casadi_int k = profiler_child(d, parent, name, suffix ? suffix : "");
+    st.node.push_back(k);
+    st.t_added.push_back(0);
+    st.t_start.push_back(profiler_tick(d.use_cycles));
+  }
+
+  void Profiler::leave() {
+    ProfilerData& d = profiler_data();
+    uint64_t t = profiler_tick(d.use_cycles);
+    ProfilerStack& st = profiler_stack;
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    // Stack may be stale after reset
+    if (st.session!=d.session || st.node.empty()) return;
+    casadi_int k = st.node.back();
+    uint64_t t0 = st.t_start.back();
+    st.node.pop_back();
+    st.t_start.pop_back();
+    st.t_added.pop_back();
+    uint64_t dt = t >= t0 ? t - t0 : 0;
+    ProfilerNode& n = d.nodes[k];
+    n.t_inclusive += dt;
+    if (d.trace && n.n_call % d.sample == 0 && d.events.size() < d.max_events) {
+      d.events.push_back(ProfilerEvent{k, st.tid, t0, t, 0});
+    }
+    n.n_call++;
+    d.nodes[n.parent].t_children += dt;
+    if (n.parent==0) d.nodes[0].t_inclusive += dt;
+  }
+
+  uint64_t Profiler::tick() {
+    return profiler_tick(profiler_data().use_cycles);
+  }
+
+  double Profiler::tick_period() {
+    return 1. / profiler_ticks_per_sec(profiler_data());
+  }
+
+  void Profiler::add(const std::string& name, casadi_int n_call, uint64_t ticks) {
+    if (n_call==0) return;
+    ProfilerData& d = profiler_data();
+    ProfilerStack& st = profiler_stack;
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    if (st.session!=d.session || st.node.empty()) return;
+    casadi_int parent = st.node.back();
+    casadi_int k = profiler_child(d, parent, name, "");
+    ProfilerNode& n = d.nodes[k];
+    n.n_call += n_call;
+    n.t_inclusive += ticks;
+    d.nodes[parent].t_children += ticks;
+    // Trace event, laid out back-to-back from the start of the enclosing scope
+    if (d.trace && d.nodes[parent].n_call % d.sample == 0 && d.events.size() < d.max_events) {
+      uint64_t t0 = st.t_start.back() + st.t_added.back();
+      d.events.push_back(ProfilerEvent{k, st.tid, t0, t0 + ticks, n_call});
+    }
+    st.t_added.back() += ticks;
+  }
+
+  Dict Profiler::stats() {
+    ProfilerData& d = profiler_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    Dict ret;
+    profiler_stats(d, 0, ret);
+    return ret;
+  }
+
+  void Profiler::to_chrome_trace(const std::string& filename) {
+    ProfilerData& d = profiler_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    std::ofstream f(filename);
+    casadi_assert(f.good(), "Profiler: cannot open \"" + filename + "\" for writing");
+    // Time origin
+    uint64_t t_origin = 0;
+    for (casadi_int i=0; i<d.events.size(); ++i) {
+      if (i==0 || d.events[i].t_start < t_origin) t_origin = d.events[i].t_start;
+    }
+    double us = 1e6 / profiler_ticks_per_sec(d);
+    f << std::setprecision(15);
+    f << "{\"traceEvents\": [";
+    for (casadi_int i=0; i<d.events.size(); ++i) {
+      const ProfilerEvent& e = d.events[i];
+      const ProfilerNode& n = d.nodes[e.node];
+      if (i>0) f << ",";
+      f << "\n{\"name\": \"" << n.name << n.suffix << "\", \"ph\": \"X\", \"pid\": 0, "
+        << "\"tid\": " << e.tid << ", "
+        << "\"ts\": " << static_cast<double>(e.t_start - t_origin) * us << ", "
+        << "\"dur\": " << static_cast<double>(e.t_stop - e.t_start) * us;
+      if (e.n_call>0) f << ", \"args\": {\"n_call\": " << e.n_call << "}";
+      f << "}";
+    }
+    f << "\n], \"displayTimeUnit\": \"ms\"}\n";
+  }
+
+  void Profiler::to_flamegraph(const std::string& filename) {
+    ProfilerData& d = profiler_data();
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(d.mtx);
+#endif // CASADI_WITH_THREAD
+    std::ofstream f(filename);
+    casadi_assert(f.good(), "Profiler: cannot open \"" + filename + "\" for writing");
+    f << std::setprecision(15);
+    profiler_flamegraph(f, d, 0);
+    f << "\n";
+  }
+
+} // namespace casadi
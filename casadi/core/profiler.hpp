@@ -0,0 +1,137 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_PROFILER_HPP
+#define CASADI_PROFILER_HPP
+
+#include "generic_type.hpp"
+
+#include <cstdint>
+
+namespace casadi {
+
+  /** \brief Hierarchical profiler for numerical evaluation
+
+      When active, every numerical Function evaluation (and every linear solver
+      factorization/solve) is recorded in a call tree keyed by the chain of
+      nested calls, so that e.g. the time an nlpsol spends inside an embedded
+      integrator, and inside the linear solver of that integrator, can be
+      separated. Each node holds the number of calls, the inclusive time and
+      the self time (inclusive time minus time spent in children).
+
+      Timestamps are taken from the CPU cycle counter where available, and
+      converted to seconds with a calibration against the steady clock.
+
+      When not active, the cost is a single test of a global flag per call.
+
+      Options for start:
+      \verbatim
+      clock       [string] Tick source: "cycles" (default) or "steady"
+      trace       [bool]   Record individual events for to_chrome_trace
+                           (default true)
+      sample      [int]    Keep only every n-th event of each node in the
+                           trace; aggregated statistics remain exact
+                           (default 1)
+      max_events  [int]    Maximum number of recorded trace events
+                           (default 1000000)
+      \endverbatim
+  */
+  class CASADI_EXPORT Profiler {
+    private:
+      /// No instances are allowed
+      Profiler();
+    public:
+      /// Start (or resume) profiling
+      static void start(const Dict& opts=Dict());
+
+      /// Stop profiling, recorded data is retained
+      static void stop();
+
+      /// Clear all recorded data
+      static void reset();
+
+      /// Is profiling active?
+      static bool is_active();
+
+      /** \brief Get the call tree
+
+          Nested dictionaries with entries "n_call", "t_inclusive", "t_self"
+          (in seconds) and "children" (a dictionary keyed by name).
+      */
+      static Dict stats();
+
+      /// Export recorded events in the Chrome trace event format (chrome://tracing)
+      static void to_chrome_trace(const std::string& filename);
+
+      /// Export the call tree as flamegraph JSON (d3-flame-graph format)
+      static void to_flamegraph(const std::string& filename);
+
+#ifndef SWIG
+      /// Global flag, read inline by ProfilerScope
+      static bool active_;
+
+      /// Enter a (nested) scope
+      static void enter(const std::string& name, const char* suffix=nullptr);
+
+      /// Leave the innermost scope
+      static void leave();
+
+      /// Read the profiler clock
+      static uint64_t tick();
+
+      /// Duration of one tick [s]
+      static double tick_period();
+
+      /** \brief Add aggregated timings as a child of the innermost scope
+
+          In the trace, the aggregate is one event carrying n_call, placed
+          after earlier aggregates at the start of the enclosing scope
+      */
+      static void add(const std::string& name, casadi_int n_call, uint64_t ticks);
+#endif // SWIG
+  };
+
+#ifndef SWIG
+  /// \cond INTERNAL
+  /** \brief RAII profiling scope, no-op unless the profiler is active
+  */
+  class CASADI_EXPORT ProfilerScope {
+    public:
+      explicit ProfilerScope(const std::string& name, const char* suffix=nullptr)
+          : on_(Profiler::active_) {
+        if (on_) Profiler::enter(name, suffix);
+      }
+      ~ProfilerScope() {
+        if (on_) Profiler::leave();
+      }
+    private:
+      bool on_;
+  };
+  /// \endcond
+#endif // SWIG
+
+} // namespace casadi
+
+#endif // CASADI_PROFILER_HPP
@@ -0,0 +1,53 @@
+// NOLINT(legal/copyright)
+// SYMBOL "interpn_batch"
+template<typename T1>
+void casadi_interpn_batch(T1* res, casadi_int ndim, const T1* grid, const casadi_int* offset, const T1* values, const T1* x, const casadi_int* lookup_mode, casadi_int m, casadi_int n, casadi_int* iw, T1* w) { // NOLINT(whitespace/line_length)
+  // Work vectors
+  T1 *alpha, *c;
+  casadi_int *index, *corner, *ind;
+  casadi_int i, j, k, ld, ng;
+  T1 xi;
+  const T1 *g, *v;
+  alpha = w; w += ndim*n;
+  c = w; w += n;
+  index = iw; iw += ndim*n;
+  corner = iw; iw += ndim;
+  ind = iw; iw += n;
+  // Left index and fraction of interval for all points, one dimension at a time
+  for (i=0; i<ndim; ++i) {
+    g = grid + offset[i];
+    ng = offset[i+1]-offset[i];
+    // Start every search from the interval of the preceding point
+    j = 0;
+    for (k=0; k<n; ++k) {
+      xi = x ? x[k*ndim+i] : 0;
+      j = index[k*ndim+i] = casadi_low_hint(xi, g, ng, lookup_mode[i], j);
+      alpha[k*ndim+i] = (xi-g[j])/(g[j+1]-g[j]);
+    }
+  }
+  // Loop over all corners, add contribution to all outputs
+  casadi_clear_casadi_int(corner, ndim);
+  casadi_clear(res, m*n);
+  do {
+    // Tensor-product weight and value offset for the corner
+    for (k=0; k<n; ++k) {
+      c[k] = 1;
+      ind[k] = 0;
+    }
+    ld = 1;
+    for (i=0; i<ndim; ++i) {
+      if (corner[i]) {
+        for (k=0; k<n; ++k) c[k] *= alpha[k*ndim+i];
+      } else {
+        for (k=0; k<n; ++k) c[k] *= 1-alpha[k*ndim+i];
+      }
+      for (k=0; k<n; ++k) ind[k] += (index[k*ndim+i]+corner[i])*ld;
+      ld *= offset[i+1]-offset[i];
+    }
+    // Accumulate
+    for (k=0; k<n; ++k) {
+      v = values + ind[k]*m;
+      for (j=0; j<m; ++j) res[k*m+j] += c[k]*v[j];
+    }
+  } while (casadi_flip(corner, ndim));
+}
@@ -0,0 +1,568 @@
+// NOLINT(legal/copyright)
+
+// C-REPLACE "fmin" "casadi_fmin"
+// C-REPLACE "fmax" "casadi_fmax"
+// C-REPLACE "std::numeric_limits<T1>::infinity()" "casadi_inf"
+// C-REPLACE "static_cast<int>" "(int) "
+// SYMBOL "ipqp_prob"
+template<typename T1>
+struct casadi_ipqp_prob {
+  // Sparsity patterns
+  const casadi_int *sp_a, *sp_h, *sp_at, *sp_kkt;
+  // Symbolic LDL factorization
+  const casadi_int *sp_lt, *perm;
+  // Dimensions
+  casadi_int nx, na, nz;
+  // Infinity
+  T1 inf;
+  // Maximum number of iterations
+  casadi_int max_iter;
+  // Primal, dual and complementarity error tolerance
+  T1 constr_viol_tol, dual_inf_tol, mu_tol;
+  // Regularization of the KKT system
+  T1 reg;
+  // Number of iterative refinement steps
+  casadi_int n_refine;
+  // Fraction-to-boundary parameter
+  T1 tau;
+};
+// C-REPLACE "casadi_ipqp_prob<T1>" "struct casadi_ipqp_prob"
+
+// SYMBOL "ipqp_setup"
+template<typename T1>
+void casadi_ipqp_setup(casadi_ipqp_prob<T1>* p) {
+  p->na = p->sp_a[0];
+  p->nx = p->sp_a[1];
+  p->nz = p->nx + p->na;
+  p->inf = std::numeric_limits<T1>::infinity();
+  p->max_iter = 100;
+  p->constr_viol_tol = 1e-8;
+  p->dual_inf_tol = 1e-8;
+  p->mu_tol = 1e-8;
+  p->reg = 1e-8;
+  p->n_refine = 2;
+  p->tau = 0.995;
+}
+
+// SYMBOL "ipqp_work"
+template<typename T1>
+void casadi_ipqp_work(const casadi_ipqp_prob<T1>* p, casadi_int* sz_iw, casadi_int* sz_w) {
+  // Local variables
+  casadi_int nnz_a, nnz_kkt, nnz_lt;
+  // Get matrix number of nonzeros
+  nnz_a = p->sp_a[2+p->sp_a[1]];
+  nnz_kkt = p->sp_kkt[2+p->sp_kkt[1]];
+  nnz_lt = p->sp_lt[2+p->sp_lt[1]];
+  // Reset sz_w, sz_iw
+  *sz_w = *sz_iw = 0;
+  // Temporary work vectors
+  *sz_w = casadi_max(*sz_w, p->nz); // casadi_ldl, casadi_ldl_solve
+  *sz_iw = casadi_max(*sz_iw, p->nz); // casadi_trans
+  // Persistent work vectors
+  *sz_w += nnz_a; // trans(a)
+  *sz_w += nnz_kkt; // kkt
+  *sz_w += nnz_lt; // lt
+  *sz_w += p->nz; // D
+  *sz_w += p->nz; // z=[xk,gk]
+  *sz_w += p->nz; // lbz
+  *sz_w += p->nz; // ubz
+  *sz_w += p->nz; // lam
+  *sz_w += 4*p->nz; // sl, su, ll, lu
+  *sz_w += p->nz; // dz
+  *sz_w += p->nz; // dlam
+  *sz_w += 4*p->nz; // dsl, dsu, dll, dlu
+  *sz_w += 2*p->nz; // cl, cu
+  *sz_w += 2*p->nz; // sigma, q
+  *sz_w += p->nz; // rhs
+  *sz_w += p->nz; // sol
+  *sz_w += p->nz; // res
+  *sz_w += p->nx; // rd
+}
+
+// SYMBOL "ipqp_flag_t"
+typedef enum {
+  IPQP_SUCCESS,
+  IPQP_MAX_ITER,
+  IPQP_NO_SEARCH_DIR,
+  IPQP_INCONSISTENT_BOUNDS,
+  IPQP_PRINTING_ERROR
+} casadi_ipqp_flag_t;
+
+// SYMBOL "ipqp_data"
+template<typename T1>
+struct casadi_ipqp_data {
+  // Problem structure
+  const casadi_ipqp_prob<T1>* prob;
+  // Solver status
+  casadi_ipqp_flag_t status;
+  // Cost
+  T1 f;
+  // QP data
+  const T1 *nz_a, *nz_h, *g;
+  // Vectors
+  T1 *z, *lbz, *ubz, *lam, *sl, *su, *ll, *lu, *w;
+  T1 *dz, *dlam, *dsl, *dsu, *dll, *dlu, *cl, *cu, *sigma, *q, *rhs, *sol, *res, *rd;
+  casadi_int *iw;
+  // Numeric LDL factorization
+  T1 *nz_at, *nz_kkt, *nz_lt, *D;
+  // Message buffer
+  const char *msg;
+  // Number of finite inequality bounds
+  casadi_int n_ineq;
+  // Primal error, dual error, complementarity, centering, step size
+  T1 pr, du, mu, sig, alpha;
+  // Iteration
+  casadi_int iter;
+};
+// C-REPLACE "casadi_ipqp_data<T1>" "struct casadi_ipqp_data"
+
+// SYMBOL "ipqp_init"
+template<typename T1>
+void casadi_ipqp_init(casadi_ipqp_data<T1>* d, casadi_int** iw, T1** w) {
+  // Local variables
+  casadi_int nnz_a, nnz_kkt, nnz_lt;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Get matrix number of nonzeros
+  nnz_a = p->sp_a[2+p->sp_a[1]];
+  nnz_kkt = p->sp_kkt[2+p->sp_kkt[1]];
+  nnz_lt = p->sp_lt[2+p->sp_lt[1]];
+  d->nz_at = *w; *w += nnz_a;
+  d->nz_kkt = *w; *w += nnz_kkt;
+  d->nz_lt = *w; *w += nnz_lt;
+  d->D = *w; *w += p->nz;
+  d->z = *w; *w += p->nz;
+  d->lbz = *w; *w += p->nz;
+  d->ubz = *w; *w += p->nz;
+  d->lam = *w; *w += p->nz;
+  d->sl = *w; *w += p->nz;
+  d->su = *w; *w += p->nz;
+  d->ll = *w; *w += p->nz;
+  d->lu = *w; *w += p->nz;
+  d->dz = *w; *w += p->nz;
+  d->dlam = *w; *w += p->nz;
+  d->dsl = *w; *w += p->nz;
+  d->dsu = *w; *w += p->nz;
+  d->dll = *w; *w += p->nz;
+  d->dlu = *w; *w += p->nz;
+  d->cl = *w; *w += p->nz;
+  d->cu = *w; *w += p->nz;
+  d->sigma = *w; *w += p->nz;
+  d->q = *w; *w += p->nz;
+  d->rhs = *w; *w += p->nz;
+  d->sol = *w; *w += p->nz;
+  d->res = *w; *w += p->nz;
+  d->rd = *w; *w += p->nx;
+  d->w = *w;
+  d->iw = *iw;
+}
+
+// SYMBOL "ipqp_reset"
+template<typename T1>
+int casadi_ipqp_reset(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int i;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Reset variables corresponding to previous iteration
+  d->msg = 0;
+  d->alpha = 0.;
+  d->sig = 0.;
+  d->iter = 0;
+  d->n_ineq = 0;
+  d->f = 0.;
+  // Transpose A
+  casadi_trans(d->nz_a, p->sp_a, d->nz_at, p->sp_at, d->iw);
+  // Check bounds, fix variables with equal bounds
+  for (i=0; i<p->nz; ++i) {
+    if (d->lbz[i] > d->ubz[i] || d->lbz[i] == p->inf || d->ubz[i] == -p->inf) {
+      d->status = IPQP_INCONSISTENT_BOUNDS;
+      d->msg = "Inconsistent bounds";
+      return 1;
+    }
+    if (i<p->nx && d->lbz[i] == d->ubz[i]) d->z[i] = d->lbz[i];
+  }
+  // Constraint values
+  casadi_clear(d->z+p->nx, p->na);
+  casadi_mv(d->nz_a, p->sp_a, d->z, d->z+p->nx, 0);
+  // Strictly positive slacks and bound multipliers
+  for (i=0; i<p->nz; ++i) {
+    d->sl[i] = d->su[i] = d->ll[i] = d->lu[i] = 0.;
+    if (d->lbz[i] == d->ubz[i]) continue;
+    if (d->lbz[i] > -p->inf) {
+      d->sl[i] = fmax(d->z[i] - d->lbz[i], 1.);
+      d->ll[i] = fmax(-d->lam[i], 1.);
+      d->n_ineq++;
+    }
+    if (d->ubz[i] < p->inf) {
+      d->su[i] = fmax(d->ubz[i] - d->z[i], 1.);
+      d->lu[i] = fmax(d->lam[i], 1.);
+      d->n_ineq++;
+    }
+    d->lam[i] = d->lu[i] - d->ll[i];
+  }
+  return 0;
+}
+
+// SYMBOL "ipqp_residual"
+// Calculate the cost, the residuals and the complementarity measure
+template<typename T1>
+void casadi_ipqp_residual(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int i;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Constraint values
+  casadi_clear(d->z+p->nx, p->na);
+  casadi_mv(d->nz_a, p->sp_a, d->z, d->z+p->nx, 0);
+  // Cost
+  d->f = casadi_bilin(d->nz_h, p->sp_h, d->z, d->z)/2. + casadi_dot(p->nx, d->z, d->g);
+  // Gradient of the Lagrangian, w.r.t. the linear constraints only
+  casadi_copy(d->g, p->nx, d->rd);
+  casadi_mv(d->nz_h, p->sp_h, d->z, d->rd, 0);
+  casadi_mv(d->nz_a, p->sp_a, d->lam+p->nx, d->rd, 1);
+  // Multipliers for fixed variables follow from dual feasibility
+  d->du = 0.;
+  for (i=0; i<p->nx; ++i) {
+    if (d->lbz[i] == d->ubz[i]) {
+      d->lam[i] = -d->rd[i];
+      d->rd[i] = 0.;
+    } else {
+      d->rd[i] += d->lam[i];
+      d->du = fmax(d->du, fabs(d->rd[i]));
+    }
+  }
+  // Primal residuals, with respect to the slacks
+  d->pr = 0.;
+  d->mu = 0.;
+  for (i=0; i<p->nz; ++i) {
+    if (d->lbz[i] == d->ubz[i]) {
+      d->pr = fmax(d->pr, fabs(d->z[i] - d->lbz[i]));
+      continue;
+    }
+    if (d->lbz[i] > -p->inf) {
+      d->pr = fmax(d->pr, fabs(d->z[i] - d->lbz[i] - d->sl[i]));
+      d->mu += d->sl[i] * d->ll[i];
+    }
+    if (d->ubz[i] < p->inf) {
+      d->pr = fmax(d->pr, fabs(d->ubz[i] - d->z[i] - d->su[i]));
+      d->mu += d->su[i] * d->lu[i];
+    }
+  }
+  if (d->n_ineq > 0) d->mu /= d->n_ineq;
+}
+
+// SYMBOL "ipqp_kkt"
+// Form and factorize the KKT system
+template<typename T1>
+int casadi_ipqp_kkt(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int i, k, eq;
+  const casadi_int *h_colind, *h_row, *a_colind, *a_row, *at_colind, *at_row,
+                   *kkt_colind, *kkt_row;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Extract sparsities
+  a_row = (a_colind = p->sp_a+2) + p->nx + 1;
+  at_row = (at_colind = p->sp_at+2) + p->na + 1;
+  h_row = (h_colind = p->sp_h+2) + p->nx + 1;
+  kkt_row = (kkt_colind = p->sp_kkt+2) + p->nz + 1;
+  // Barrier contribution of the bounds
+  for (i=0; i<p->nz; ++i) {
+    d->sigma[i] = 0.;
+    if (d->lbz[i] == d->ubz[i]) continue;
+    if (d->lbz[i] > -p->inf) d->sigma[i] += d->ll[i] / d->sl[i];
+    if (d->ubz[i] < p->inf) d->sigma[i] += d->lu[i] / d->su[i];
+  }
+  // Reset w to zero
+  casadi_clear(d->w, p->nz);
+  // Loop over rows of the (transposed) KKT
+  for (i=0; i<p->nz; ++i) {
+    eq = d->lbz[i] == d->ubz[i];
+    if (i<p->nx) {
+      if (eq) {
+        // Fixed variable: zero step
+        d->w[i] = 1.;
+      } else {
+        for (k=h_colind[i]; k<h_colind[i+1]; ++k) d->w[h_row[k]] = d->nz_h[k];
+        for (k=a_colind[i]; k<a_colind[i+1]; ++k) {
+          if (d->lbz[p->nx+a_row[k]] < d->ubz[p->nx+a_row[k]] && d->sigma[p->nx+a_row[k]]==0) {
+            continue;
+          }
+          d->w[p->nx+a_row[k]] = d->nz_a[k];
+        }
+        // Skip entries corresponding to fixed variables
+        for (k=h_colind[i]; k<h_colind[i+1]; ++k) {
+          if (d->lbz[h_row[k]] == d->ubz[h_row[k]]) d->w[h_row[k]] = 0.;
+        }
+        d->w[i] += d->sigma[i] + p->reg;
+      }
+    } else {
+      if (eq) {
+        d->w[i] = -p->reg;
+      } else if (d->sigma[i]==0) {
+        // Unbounded constraint: zero multiplier step
+        d->w[i] = -1.;
+      } else {
+        d->w[i] = -1./d->sigma[i] - p->reg;
+      }
+      if (eq || d->sigma[i]>0) {
+        for (k=at_colind[i-p->nx]; k<at_colind[i-p->nx+1]; ++k) {
+          if (d->lbz[at_row[k]] == d->ubz[at_row[k]]) continue;
+          d->w[at_row[k]] = d->nz_at[k];
+        }
+      }
+    }
+    // Copy row to KKT, zero out w
+    for (k=kkt_colind[i]; k<kkt_colind[i+1]; ++k) {
+      d->nz_kkt[k] = d->w[kkt_row[k]];
+      d->w[kkt_row[k]] = 0;
+    }
+  }
+  // Factorize
+  casadi_ldl(p->sp_kkt, d->nz_kkt, p->sp_lt, d->nz_lt, d->D, p->perm, d->w);
+  // Quasi-definite system: no zero pivots expected
+  for (i=0; i<p->nz; ++i) {
+    if (d->D[i] == 0. || d->D[i] != d->D[i]) return 1;
+  }
+  return 0;
+}
+
+// SYMBOL "ipqp_direction"
+// Calculate a search direction for the complementarity targets cl, cu
+template<typename T1>
+void casadi_ipqp_direction(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int i, k;
+  T1 rl, ru;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Condense the bound contributions into q
+  for (i=0; i<p->nz; ++i) {
+    d->q[i] = 0.;
+    if (d->lbz[i] == d->ubz[i]) continue;
+    if (d->lbz[i] > -p->inf) {
+      rl = d->z[i] - d->lbz[i] - d->sl[i];
+      d->q[i] -= (d->cl[i] - d->ll[i] * rl) / d->sl[i];
+    }
+    if (d->ubz[i] < p->inf) {
+      ru = d->ubz[i] - d->z[i] - d->su[i];
+      d->q[i] += (d->cu[i] - d->lu[i] * ru) / d->su[i];
+    }
+  }
+  // Right-hand side
+  for (i=0; i<p->nz; ++i) {
+    if (i<p->nx) {
+      d->rhs[i] = d->lbz[i] == d->ubz[i] ? 0. : -d->rd[i] - d->q[i];
+    } else if (d->lbz[i] == d->ubz[i]) {
+      d->rhs[i] = d->lbz[i] - d->z[i];
+    } else if (d->sigma[i] == 0) {
+      d->rhs[i] = 0.;
+    } else {
+      d->rhs[i] = -d->q[i] / d->sigma[i];
+    }
+  }
+  // Solve the KKT system
+  casadi_copy(d->rhs, p->nz, d->sol);
+  casadi_ldl_solve(d->sol, 1, p->sp_lt, d->nz_lt, d->D, p->perm, d->w);
+  // Iterative refinement with respect to the unregularized KKT system
+  for (k=0; k<p->n_refine; ++k) {
+    casadi_clear(d->res, p->nz);
+    casadi_mv(d->nz_kkt, p->sp_kkt, d->sol, d->res, 0);
+    for (i=0; i<p->nz; ++i) {
+      d->res[i] = d->rhs[i] - d->res[i];
+      if (i<p->nx) {
+        if (d->lbz[i] != d->ubz[i]) d->res[i] += p->reg * d->sol[i];
+      } else if (d->lbz[i] == d->ubz[i] || d->sigma[i] > 0) {
+        d->res[i] -= p->reg * d->sol[i];
+      }
+    }
+    casadi_ldl_solve(d->res, 1, p->sp_lt, d->nz_lt, d->D, p->perm, d->w);
+    casadi_axpy(p->nz, 1., d->res, d->sol);
+  }
+  // Primal step
+  casadi_copy(d->sol, p->nx, d->dz);
+  casadi_clear(d->dz+p->nx, p->na);
+  casadi_mv(d->nz_a, p->sp_a, d->dz, d->dz+p->nx, 0);
+  // Dual step
+  for (i=0; i<p->nz; ++i) {
+    if (d->lbz[i] == d->ubz[i]) {
+      d->dlam[i] = i<p->nx ? 0. : d->sol[i];
+    } else {
+      d->dlam[i] = d->sigma[i] * d->dz[i] + d->q[i];
+    }
+  }
+  // Slack and bound multiplier steps
+  for (i=0; i<p->nz; ++i) {
+    d->dsl[i] = d->dsu[i] = d->dll[i] = d->dlu[i] = 0.;
+    if (d->lbz[i] == d->ubz[i]) continue;
+    if (d->lbz[i] > -p->inf) {
+      rl = d->z[i] - d->lbz[i] - d->sl[i];
+      d->dsl[i] = rl + d->dz[i];
+      d->dll[i] = (d->cl[i] - d->ll[i] * d->dsl[i]) / d->sl[i];
+    }
+    if (d->ubz[i] < p->inf) {
+      ru = d->ubz[i] - d->z[i] - d->su[i];
+      d->dsu[i] = ru - d->dz[i];
+      d->dlu[i] = (d->cu[i] - d->lu[i] * d->dsu[i]) / d->su[i];
+    }
+  }
+}
+
+// SYMBOL "ipqp_max_step"
+// Largest step in [0, 1] keeping a fraction tau of the distance to the boundary
+template<typename T1>
+T1 casadi_ipqp_max_step(casadi_ipqp_data<T1>* d, T1 tau) {
+  // Local variables
+  casadi_int i;
+  T1 alpha;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  alpha = 1.;
+  for (i=0; i<p->nz; ++i) {
+    if (d->lbz[i] == d->ubz[i]) continue;
+    if (d->lbz[i] > -p->inf) {
+      if (d->dsl[i] < 0) alpha = fmin(alpha, -tau * d->sl[i] / d->dsl[i]);
+      if (d->dll[i] < 0) alpha = fmin(alpha, -tau * d->ll[i] / d->dll[i]);
+    }
+    if (d->ubz[i] < p->inf) {
+      if (d->dsu[i] < 0) alpha = fmin(alpha, -tau * d->su[i] / d->dsu[i]);
+      if (d->dlu[i] < 0) alpha = fmin(alpha, -tau * d->lu[i] / d->dlu[i]);
+    }
+  }
+  return alpha;
+}
+
+// SYMBOL "ipqp_prepare"
+template<typename T1>
+int casadi_ipqp_prepare(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Calculate residuals
+  casadi_ipqp_residual(d);
+  // Termination message
+  if (d->pr <= p->constr_viol_tol && d->du <= p->dual_inf_tol && d->mu <= p->mu_tol) {
+    d->status = IPQP_SUCCESS;
+    d->msg = "Converged";
+    return 1;
+  } else if (d->iter >= p->max_iter) {
+    d->status = IPQP_MAX_ITER;
+    d->msg = "Max iter";
+    return 1;
+  } else {
+    // Keep iterating
+    return 0;
+  }
+}
+
+// SYMBOL "ipqp_iterate"
+// Mehrotra predictor-corrector step
+template<typename T1>
+int casadi_ipqp_iterate(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int i;
+  T1 mu_aff;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Reset message flag
+  d->msg = 0;
+  // Start a new iteration
+  d->iter++;
+  // Form and factorize the KKT system
+  if (casadi_ipqp_kkt(d)) {
+    d->status = IPQP_NO_SEARCH_DIR;
+    d->msg = "Singular KKT system";
+    return 1;
+  }
+  // Affine scaling direction
+  for (i=0; i<p->nz; ++i) {
+    d->cl[i] = -d->sl[i] * d->ll[i];
+    d->cu[i] = -d->su[i] * d->lu[i];
+  }
+  casadi_ipqp_direction(d);
+  d->sig = 0.;
+  if (d->n_ineq > 0) {
+    // Complementarity after the affine step
+    d->alpha = casadi_ipqp_max_step(d, 1.);
+    mu_aff = 0.;
+    for (i=0; i<p->nz; ++i) {
+      if (d->lbz[i] == d->ubz[i]) continue;
+      if (d->lbz[i] > -p->inf) {
+        mu_aff += (d->sl[i] + d->alpha * d->dsl[i]) * (d->ll[i] + d->alpha * d->dll[i]);
+      }
+      if (d->ubz[i] < p->inf) {
+        mu_aff += (d->su[i] + d->alpha * d->dsu[i]) * (d->lu[i] + d->alpha * d->dlu[i]);
+      }
+    }
+    mu_aff /= d->n_ineq;
+    // Centering parameter
+    d->sig = d->mu > 0 ? mu_aff / d->mu : 0.;
+    d->sig = d->sig * d->sig * d->sig;
+    d->sig = fmin(d->sig, 1.);
+    // Centering-corrector direction
+    for (i=0; i<p->nz; ++i) {
+      d->cl[i] = d->sig * d->mu - d->sl[i] * d->ll[i] - d->dsl[i] * d->dll[i];
+      d->cu[i] = d->sig * d->mu - d->su[i] * d->lu[i] - d->dsu[i] * d->dlu[i];
+    }
+    casadi_ipqp_direction(d);
+  }
+  // Take step
+  d->alpha = casadi_ipqp_max_step(d, p->tau);
+  casadi_axpy(p->nx, d->alpha, d->dz, d->z);
+  for (i=0; i<p->nz; ++i) {
+    if (d->lbz[i] == d->ubz[i]) {
+      d->lam[i] += d->alpha * d->dlam[i];
+      continue;
+    }
+    d->sl[i] += d->alpha * d->dsl[i];
+    d->su[i] += d->alpha * d->dsu[i];
+    d->ll[i] += d->alpha * d->dll[i];
+    d->lu[i] += d->alpha * d->dlu[i];
+    d->lam[i] = d->lu[i] - d->ll[i];
+  }
+  // Keep iterating
+  return 0;
+}
+
+// The following routines require stdio
+#ifndef CASADI_PRINTF
+
+// SYMBOL "ipqp_print_header"
+template<typename T1>
+int casadi_ipqp_print_header(casadi_ipqp_data<T1>* d, char* buf, size_t buf_sz) {
+  int flag;
+  // Print to string
+  flag = snprintf(buf, buf_sz, "%5s %9s %9s %9s %9s %9s %9s  %4s",
+          "Iter", "fk", "|pr|", "|du|", "mu", "sigma", "alpha", "Note");
+  // Check if error
+  if (flag < 0) {
+    d->status = IPQP_PRINTING_ERROR;
+    return 1;
+  }
+  // Successful return
+  return 0;
+}
+
+// SYMBOL "ipqp_print_iteration"
+template<typename T1>
+int casadi_ipqp_print_iteration(casadi_ipqp_data<T1>* d, char* buf, int buf_sz) {
+  int flag;
+  // Print iteration data without note to string
+  flag = snprintf(buf, buf_sz,
+    "%5d %9.2g %9.2g %9.2g %9.2g %9.2g %9.2g  ",
+    static_cast<int>(d->iter), d->f, d->pr, d->du, d->mu, d->sig, d->alpha);
+  // Check if error
+  if (flag < 0) {
+    d->status = IPQP_PRINTING_ERROR;
+    return 1;
+  }
+  // Rest of buffer reserved for iteration note
+  buf += flag;
+  buf_sz -= flag;
+  // Print iteration note, if any
+  if (d->msg) {
+    flag = snprintf(buf, buf_sz, "%s", d->msg);
+    // Check if error
+    if (flag < 0) {
+      d->status = IPQP_PRINTING_ERROR;
+      return 1;
+    }
+  }
+  // Successful return
+  return 0;
+}
+
+#endif  // CASADI_PRINTF
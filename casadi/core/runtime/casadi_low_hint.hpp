@@ -0,0 +1,52 @@
+// NOLINT(legal/copyright)
+// SYMBOL "low_hint"
+template<typename T1>
+casadi_int casadi_low_hint(T1 x, const T1* grid, casadi_int ng, casadi_int lookup_mode, casadi_int hint) { // NOLINT(whitespace/line_length)
+  casadi_int lo, hi, step, mid;
+  // Equidistant grid: direct lookup is cheaper than any search
+  if (lookup_mode==1 || ng<3) return casadi_low(x, grid, ng, lookup_mode);
+  // Start from the interval of the hint
+  lo = hint;
+  if (lo<0) lo = 0;
+  if (lo>ng-2) lo = ng-2;
+  if (lo>0 && x<grid[lo]) {
+    // Gallop to the left until grid[lo] <= x
+    hi = lo;
+    step = 1;
+    while (1) {
+      lo = hi-step;
+      if (lo<=0) {
+        lo = 0;
+        break;
+      }
+      if (!(x<grid[lo])) break;
+      hi = lo;
+      step *= 2;
+    }
+  } else {
+    // Quick return: still in the same interval
+    if (lo==ng-2 || x<grid[lo+1]) return lo;
+    // Gallop to the right until x < grid[hi]
+    step = 1;
+    while (1) {
+      hi = lo+step;
+      if (hi>=ng-1) {
+        hi = ng-1;
+        break;
+      }
+      if (x<grid[hi]) break;
+      lo = hi;
+      step *= 2;
+    }
+  }
+  // Bisect: grid[lo] <= x < grid[hi]
+  while (hi-lo>1) {
+    mid = (lo+hi)/2;
+    if (x<grid[mid]) {
+      hi = mid;
+    } else {
+      lo = mid;
+    }
+  }
+  return lo;
+}
@@ -150,6 +150,11 @@ namespace casadi {
   template<typename T1>
   casadi_int casadi_low(T1 x, const T1* grid, casadi_int ng, casadi_int lookup_mode);
 
+  // Find the interval to which a value belongs, starting from a guess
+  template<typename T1>
+  casadi_int casadi_low_hint(T1 x, const T1* grid, casadi_int ng, casadi_int lookup_mode,
+                             casadi_int hint);
+
   // Get weights for the multilinear interpolant
   template<typename T1>
   void casadi_interpn_weights(casadi_int ndim, const T1* grid, const casadi_int* offset,
@@ -166,6 +171,12 @@ namespace casadi {
   T1 casadi_interpn(casadi_int ndim, const T1* grid, const casadi_int* offset, const T1* values,
                             const T1* x, casadi_int* iw, T1* w);
 
+  // Multilinear interpolant, many points at once
+  template<typename T1>
+  void casadi_interpn_batch(T1* res, casadi_int ndim, const T1* grid, const casadi_int* offset,
+                            const T1* values, const T1* x, const casadi_int* lookup_mode,
+                            casadi_int m, casadi_int n, casadi_int* iw, T1* w);
+
   // Multilinear interpolant - calculate gradient
   template<typename T1>
   void casadi_interpn_grad(T1* grad, casadi_int ndim, const T1* grid, const casadi_int* offset,
@@ -252,6 +263,7 @@ namespace casadi {
   #include "casadi_bilin.hpp"
   #include "casadi_rank1.hpp"
   #include "casadi_low.hpp"
+  #include "casadi_low_hint.hpp"
   #include "casadi_flip.hpp"
   #include "casadi_polyval.hpp"
   #include "casadi_de_boor.hpp"
@@ -260,6 +272,7 @@ namespace casadi {
   #include "casadi_interpn_weights.hpp"
   #include "casadi_interpn_interpolate.hpp"
   #include "casadi_interpn.hpp"
+  #include "casadi_interpn_batch.hpp"
   #include "casadi_interpn_grad.hpp"
   #include "casadi_mv_dense.hpp"
   #include "casadi_finite_diff.hpp"
@@ -267,6 +280,7 @@ namespace casadi {
   #include "casadi_ldl.hpp"
   #include "casadi_qr.hpp"
   #include "casadi_qp.hpp"
+  #include "casadi_ipqp.hpp"
   #include "casadi_nlp.hpp"
   #include "casadi_sqpmethod.hpp"
   #include "casadi_bfgs.hpp"
@@ -688,6 +688,10 @@ namespace casadi {
     return (*this)->amd();
   }
 
+  std::vector<casadi_int> Sparsity::nested_dissection(casadi_int leaf_size) const {
+    return (*this)->nested_dissection(leaf_size);
+  }
+
   casadi_int Sparsity::btf(std::vector<casadi_int>& rowperm, std::vector<casadi_int>& colperm,
                             std::vector<casadi_int>& rowblock, std::vector<casadi_int>& colblock,
                             std::vector<casadi_int>& coarse_rowblock,
@@ -773,6 +773,16 @@ namespace casadi {
     */
     std::vector<casadi_int> amd() const;
 
+    /** \brief Nested dissection preordering
+      Fill-reducing ordering for linear systems arising from grid-structured
+      (e.g. discretized PDE) problems, for which it typically gives less fill-in than AMD.
+      The adjacency graph is split recursively using level-set vertex separators,
+      which are numbered last. Subgraphs with at most leaf_size nodes are ordered with AMD.
+      The system must be symmetric, for an unsymmetric matrix A, first form the square
+      of the pattern, A'*A.
+    */
+    std::vector<casadi_int> nested_dissection(casadi_int leaf_size=64) const;
+
 #ifndef SWIG
     /** \brief Propagate sparsity through a linear solve
      */
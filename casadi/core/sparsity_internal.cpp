@@ -961,6 +961,153 @@ namespace casadi {
     #undef FLIP
   }
 
+  std::vector<casadi_int> SparsityInternal::nested_dissection(casadi_int leaf_size) const {
+    casadi_assert(is_symmetric(), "Nested dissection requires a symmetric matrix");
+    casadi_assert(leaf_size>=1, "Leaf size must be positive");
+    casadi_int n = size2();
+    // Independent blocks are the connected components of the adjacency graph
+    vector<casadi_int> index, offset;
+    scc(index, offset);
+    // Work vectors, shared by all recursive calls
+    vector<casadi_int> tag(n, -1), level(n, -1), queue(n);
+    casadi_int ntag = 0;
+    // Order each block separately
+    vector<casadi_int> p;
+    p.reserve(n);
+    for (casadi_int b=0; b+1<offset.size(); ++b) {
+      vector<casadi_int> nodes(index.begin()+offset[b], index.begin()+offset[b+1]);
+      nested_dissection(nodes, leaf_size, p, tag, level, queue, ntag);
+    }
+    return p;
+  }
+
+  casadi_int SparsityInternal::level_sets(casadi_int root, casadi_int t,
+      const std::vector<casadi_int>& tag, std::vector<casadi_int>& level,
+      std::vector<casadi_int>& queue, casadi_int& nlev) const {
+    const casadi_int* colind = this->colind();
+    const casadi_int* row = this->row();
+    // Breadth-first search, restricted to nodes with the tag t
+    casadi_int head = 0, tail = 0;
+    queue[tail++] = root;
+    level[root] = 0;
+    nlev = 1;
+    while (head<tail) {
+      casadi_int v = queue[head++];
+      for (casadi_int k=colind[v]; k<colind[v+1]; ++k) {
+        casadi_int w = row[k];
+        if (tag[w]!=t || level[w]>=0) continue;
+        level[w] = level[v] + 1;
+        nlev = std::max(nlev, level[w] + 1);
+        queue[tail++] = w;
+      }
+    }
+    return tail;
+  }
+
+  void SparsityInternal::nested_dissection(const std::vector<casadi_int>& nodes,
+      casadi_int leaf_size, std::vector<casadi_int>& p, std::vector<casadi_int>& tag,
+      std::vector<casadi_int>& level, std::vector<casadi_int>& queue, casadi_int& ntag) const {
+    const casadi_int* colind = this->colind();
+    const casadi_int* row = this->row();
+    casadi_int nn = nodes.size();
+    if (nn==0) return;
+    // Level structure, unless the subgraph is small enough to be ordered directly
+    casadi_int nlev = 0;
+    if (nn>leaf_size) {
+      // Mark the nodes of the subgraph
+      casadi_int t = ntag++;
+      for (casadi_int v : nodes) {
+        tag[v] = t;
+        level[v] = -1;
+      }
+      // Removing a separator may have disconnected the subgraph
+      casadi_int nq = level_sets(nodes.front(), t, tag, level, queue, nlev);
+      if (nq<nn) {
+        vector<vector<casadi_int> > comp(1, vector<casadi_int>(queue.begin(), queue.begin()+nq));
+        for (casadi_int v : nodes) {
+          if (level[v]>=0) continue;
+          casadi_int dummy;
+          nq = level_sets(v, t, tag, level, queue, dummy);
+          comp.push_back(vector<casadi_int>(queue.begin(), queue.begin()+nq));
+        }
+        for (auto&& c : comp) nested_dissection(c, leaf_size, p, tag, level, queue, ntag);
+        return;
+      }
+      // Find a pseudo-peripheral root, giving a long and narrow level structure
+      casadi_int root = nodes.front();
+      for (casadi_int iter=0; iter<5; ++iter) {
+        // Node of minimum degree in the last level
+        casadi_int cand = -1;
+        for (casadi_int k=0; k<nn; ++k) {
+          casadi_int v = queue[k];
+          if (level[v]!=nlev-1) continue;
+          if (cand<0 || colind[v+1]-colind[v] < colind[cand+1]-colind[cand]) cand = v;
+        }
+        // Level structure rooted at the candidate
+        for (casadi_int v : nodes) level[v] = -1;
+        casadi_int nlev_cand;
+        level_sets(cand, t, tag, level, queue, nlev_cand);
+        if (nlev_cand>nlev) {
+          root = cand;
+          nlev = nlev_cand;
+        } else {
+          // No improvement, restore level structure of the current root
+          if (nlev_cand<nlev) {
+            for (casadi_int v : nodes) level[v] = -1;
+            level_sets(root, t, tag, level, queue, nlev);
+          }
+          break;
+        }
+      }
+    }
+
+    // Too small or too densely connected to be split
+    if (nlev<3) {
+      if (nn<=2) {
+        p.insert(p.end(), nodes.begin(), nodes.end());
+      } else {
+        // Approximate minimum degree ordering of the subgraph
+        vector<casadi_int> mapping;
+        vector<casadi_int> q = shared_from_this<Sparsity>().sub(nodes, nodes, mapping).amd();
+        for (casadi_int k : q) p.push_back(nodes[k]);
+      }
+      return;
+    }
+
+    // Separator level: the level at which half of the nodes have been visited
+    vector<casadi_int> count(nlev, 0);
+    for (casadi_int v : nodes) count[level[v]]++;
+    casadi_int sep_level = 0, cum = 0;
+    while (sep_level<nlev-1 && 2*(cum + count[sep_level]) < nn) cum += count[sep_level++];
+    sep_level = std::min(std::max(sep_level, casadi_int(1)), nlev-2);
+
+    // Partition the nodes, only keeping separator nodes which are adjacent to the next level
+    vector<casadi_int> part1, part2, sep;
+    for (casadi_int v : nodes) {
+      if (level[v]<sep_level) {
+        part1.push_back(v);
+      } else if (level[v]>sep_level) {
+        part2.push_back(v);
+      } else {
+        bool adjacent = false;
+        for (casadi_int k=colind[v]; k<colind[v+1] && !adjacent; ++k) {
+          casadi_int w = row[k];
+          adjacent = tag[w]==tag[v] && level[w]==sep_level+1;
+        }
+        if (adjacent) {
+          sep.push_back(v);
+        } else {
+          part1.push_back(v);
+        }
+      }
+    }
+
+    // Order the two parts recursively, followed by the separator
+    nested_dissection(part1, leaf_size, p, tag, level, queue, ntag);
+    nested_dissection(part2, leaf_size, p, tag, level, queue, ntag);
+    p.insert(p.end(), sep.begin(), sep.end());
+  }
+
   void SparsityInternal::bfs(casadi_int n, std::vector<casadi_int>& wi, std::vector<casadi_int>& wj,
                               std::vector<casadi_int>& queue, const std::vector<casadi_int>& imatch,
                               const std::vector<casadi_int>& jmatch, casadi_int mark) const {
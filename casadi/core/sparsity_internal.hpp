@@ -117,6 +117,28 @@ namespace casadi {
       */
     std::vector<casadi_int> amd() const;
 
+    /** \brief Nested dissection preordering
+      * Recursively splits the adjacency graph of a symmetric matrix with level-set
+      * vertex separators, numbering the separators last. Subgraphs with at most
+      * leaf_size nodes are ordered with AMD.
+      */
+    std::vector<casadi_int> nested_dissection(casadi_int leaf_size) const;
+
+    /** \brief Recursive step of the nested dissection, appends the ordering of nodes to p
+      * len[tag] == len[level] == len[queue] == ncol
+      */
+    void nested_dissection(const std::vector<casadi_int>& nodes, casadi_int leaf_size,
+                           std::vector<casadi_int>& p, std::vector<casadi_int>& tag,
+                           std::vector<casadi_int>& level, std::vector<casadi_int>& queue,
+                           casadi_int& ntag) const;
+
+    /** \brief Level structure of the subgraph with nodes tagged t, rooted at root
+      * Returns the number of nodes reached, which are stored in queue
+      */
+    casadi_int level_sets(casadi_int root, casadi_int t, const std::vector<casadi_int>& tag,
+                          std::vector<casadi_int>& level, std::vector<casadi_int>& queue,
+                          casadi_int& nlev) const;
+
     /** \brief Calculate the elimination tree for a matrix
       * len[w] >= ata ? ncol + nrow : ncol
       * len[parent] == ncol
@@ -43,6 +43,10 @@ namespace casadi {
   // Allocate storage for the caching
   CACHING_MAP<casadi_int, IntegerSX*> IntegerSX::cached_constants_;
   CACHING_MAP<double, RealtypeSX*> RealtypeSX::cached_constants_;
+  SXNodeTable SXNode::cached_nodes_;
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+  std::recursive_mutex SXNode::cache_mtx_;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
 
   SXElem::SXElem() {
     node = casadi_limits<SXElem>::nan.node;
@@ -63,6 +67,10 @@ namespace casadi {
   }
 
   SXElem::SXElem(double val) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Reference a cached constant before another thread can release it
+    std::lock_guard<std::recursive_mutex> lock(SXNode::cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     // Only ints fit here, not casadi_int
     int intval = static_cast<int>(val);
     if (val-static_cast<double>(intval) == 0) { // check if integer
@@ -110,20 +118,18 @@ namespace casadi {
   }
 
   SXNode* SXElem::assignNoDelete(const SXElem& scalar) {
-    // Return value
-    SXNode* ret = node;
-
     // quick return if the old and new pointers point to the same object
-    if (node == scalar.node) return ret;
+    if (node == scalar.node) return nullptr;
 
     // decrease the counter but do not delete if this was the last pointer
-    --node->count;
+    // (a single decrement, since other threads may release the node concurrently)
+    SXNode* ret = --node->count == 0 ? node : nullptr;
 
     // save the new pointer
     node = scalar.node;
     node->count++;
 
-    // Return a pointer to the old node
+    // Return a pointer to the old node, if no longer referenced
     return ret;
   }
 
@@ -598,6 +604,10 @@ namespace casadi {
   }
 
   SXElem SXElem::deserialize(DeserializingStream& s) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Constants are looked up in the caches
+    std::lock_guard<std::recursive_mutex> lock(SXNode::cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     return SXElem::create(SXNode::deserialize(s));
   }
 
@@ -205,7 +205,8 @@ namespace casadi {
     void assignIfDuplicate(const SXElem& scalar, casadi_int depth=1);
 
     /** \brief Assign the node to something, without invoking the deletion of the node,
-     * if the count reaches 0 */
+     * if the count reaches 0. Returns the old node if this was its last reference,
+     * otherwise null */
     SXNode* assignNoDelete(const SXElem& scalar);
     /// \endcond
 
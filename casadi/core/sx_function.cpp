@@ -25,6 +25,7 @@
 
 #include "sx_function.hpp"
 #include <limits>
+#include <map>
 #include <stack>
 #include <deque>
 #include <fstream>
@@ -37,12 +38,173 @@
 #include "global_options.hpp"
 #include "casadi_interrupt.hpp"
 #include "serializing_stream.hpp"
+#include "tape_ad.hpp"
+
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+#include <exception>
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
 
 namespace casadi {
 
   using namespace std;
 
 
+  namespace {
+    // Second order partial derivatives of an operation, as a function of its arguments
+    struct SecondDerivatives {
+      // d2f/dx2, d2f/dxdy, d2f/dy2
+      Function f;
+      // All identically zero?
+      bool zero;
+      // Result and work vectors
+      std::vector<SXElem> res, w;
+      std::vector<casadi_int> iw;
+
+      void init(casadi_int op) {
+        SX x = SX::sym("x"), y = SX::sym("y");
+        SXElem r, d[2];
+        casadi_math<SXElem>::fun(op, x.scalar(), y.scalar(), r);
+        casadi_math<SXElem>::der(op, x.scalar(), y.scalar(), r, d);
+        SX H = SX::jacobian(SX(std::vector<SXElem>{d[0], d[1]}), vertcat(x, y));
+        SX h = densify(vertcat(H(0, 0), H(0, 1), H(1, 1)));
+        zero = true;
+        for (auto&& e : h.nonzeros()) zero = zero && e.is_zero();
+        f = Function("d2", {x, y}, {h});
+        res.resize(3, 0);
+        w.resize(f.sz_w());
+        iw.resize(f.sz_iw());
+      }
+
+      void eval(const SXElem& x, const SXElem& y) {
+        const SXElem* arg[2] = {&x, &y};
+        SXElem* r[1] = {get_ptr(res)};
+        f(arg, r, get_ptr(iw), get_ptr(w));
+      }
+    };
+
+    // Add to a symmetric entry of interactions stored as adjacency lists
+    void add_sym(std::vector<std::map<casadi_int, SXElem> >& W, casadi_int j, casadi_int k,
+                 const SXElem& v) {
+      auto ins = W[j].insert(std::make_pair(k, v));
+      if (!ins.second) ins.first->second += v;
+      if (j!=k) {
+        ins = W[k].insert(std::make_pair(j, v));
+        if (!ins.second) ins.first->second += v;
+      }
+    }
+
+    // Call sweep(d0, d1) for ranges of n directions, in parallel if supported
+    template<typename F>
+    void for_directions(casadi_int n, const F& sweep) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      casadi_int n_thread = std::min(n, GlobalOptions::max_num_threads_ad);
+      if (n_thread>1) {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> err(n_thread);
+        for (casadi_int t=0; t<n_thread; ++t) {
+          threads.emplace_back([&sweep, &err, t, n, n_thread]() {
+            try {
+              sweep(t*n/n_thread, (t+1)*n/n_thread);
+            } catch (...) {
+              err[t] = std::current_exception();
+            }
+          });
+        }
+        for (auto&& th : threads) th.join();
+        for (auto&& e : err) {
+          if (e) std::rethrow_exception(e);
+        }
+        return;
+      }
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+      sweep(0, n);
+    }
+
+    // Constant of an instruction, stored in the instruction or in a pool
+    inline double tape_const(const ScalarAtomic& e, const double* pool) {
+      return e.d;
+    }
+    inline double tape_const(const SXFunction::CompactEl& e, const double* pool) {
+      return pool[e.i1];
+    }
+
+    // Numerical evaluation of an algorithm
+    template<typename El>
+    void eval_tape(const std::vector<El>& alg, const double* pool,
+                   const double** arg, double** res, double* w) {
+      for (auto&& e : alg) {
+        switch (e.op) {
+          CASADI_MATH_FUN_BUILTIN(w[e.i1], w[e.i2], w[e.i0])
+
+        case OP_CONST: w[e.i0] = tape_const(e, pool); break;
+        case OP_INPUT: w[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2]; break;
+        case OP_OUTPUT: if (res[e.i0]!=nullptr) res[e.i0][e.i2] = w[e.i1]; break;
+        default:
+          casadi_error("Unknown operation" + str(e.op));
+        }
+      }
+    }
+
+    // Forward sparsity propagation through an algorithm
+    template<typename El>
+    void sp_forward_tape(const std::vector<El>& alg,
+                         const bvec_t** arg, bvec_t** res, bvec_t* w) {
+      for (auto&& e : alg) {
+        switch (e.op) {
+        case OP_CONST:
+        case OP_PARAMETER:
+          w[e.i0] = 0; break;
+        case OP_INPUT:
+          w[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2];
+          break;
+        case OP_OUTPUT:
+          if (res[e.i0]!=nullptr) res[e.i0][e.i2] = w[e.i1];
+          break;
+        default: // Unary or binary operation
+          w[e.i0] = w[e.i1] | w[e.i2]; break;
+        }
+      }
+    }
+
+    // Reverse sparsity propagation through an algorithm
+    template<typename El>
+    void sp_reverse_tape(const std::vector<El>& alg,
+                         bvec_t** arg, bvec_t** res, bvec_t* w) {
+      for (auto it=alg.rbegin(); it!=alg.rend(); ++it) {
+        // Temp seed
+        bvec_t seed;
+
+        // Propagate seeds
+        switch (it->op) {
+        case OP_CONST:
+        case OP_PARAMETER:
+          w[it->i0] = 0;
+          break;
+        case OP_INPUT:
+          if (arg[it->i1]!=nullptr) arg[it->i1][it->i2] |= w[it->i0];
+          w[it->i0] = 0;
+          break;
+        case OP_OUTPUT:
+          if (res[it->i0]!=nullptr) {
+            w[it->i1] |= res[it->i0][it->i2];
+            res[it->i0][it->i2] = 0;
+          }
+          break;
+        default: // Unary or binary operation
+          seed = w[it->i0];
+          w[it->i0] = 0;
+          w[it->i1] |= seed;
+          w[it->i2] |= seed;
+        }
+      }
+    }
+  } // namespace
+
   SXFunction::SXFunction(const std::string& name,
                          const vector<SX >& inputv,
                          const vector<SX >& outputv,
@@ -53,6 +215,9 @@ namespace casadi {
     // Default (persistent) options
     just_in_time_opencl_ = false;
     just_in_time_sparsity_ = false;
+    profile_instructions_ = false;
+    tape_ad_ = false;
+    compact_tape_ = true;
   }
 
   SXFunction::~SXFunction() {
@@ -71,12 +236,39 @@ namespace casadi {
                    + str(free_vars_) + " are free.");
     }
 
+    // Instrumented evaluation
+    if (profile_instructions_) return eval_profile(arg, res, w, mem);
+
     // NOTE: The implementation of this function is very delicate. Small changes in the
     // class structure can cause large performance losses. For this reason,
     // the preprocessor macros are used below
 
     // Evaluate the algorithm
-    for (auto&& e : algorithm_) {
+    if (compact_algorithm_.empty()) {
+      eval_tape(algorithm_, nullptr, arg, res, w);
+    } else {
+      eval_tape(compact_algorithm_, get_ptr(compact_constants_), arg, res, w);
+    }
+    return 0;
+  }
+
+  int SXFunction::eval_profile(const double** arg, double** res, double* w, void* mem) const {
+    auto m = static_cast<XFunctionMemory*>(mem);
+    std::fill(m->instr_n_call.begin(), m->instr_n_call.end(), 0);
+    std::fill(m->instr_ticks.begin(), m->instr_ticks.end(), 0);
+
+    // Read the clock only when the instruction category changes
+    casadi_int cat = -1;
+    uint64_t t0 = 0;
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      if (instr_cat_[k]!=cat) {
+        uint64_t t = Profiler::tick();
+        if (cat>=0) m->instr_ticks[cat] += t - t0;
+        cat = instr_cat_[k];
+        t0 = t;
+      }
+      m->instr_n_call[cat]++;
       switch (e.op) {
         CASADI_MATH_FUN_BUILTIN(w[e.i1], w[e.i2], w[e.i0])
 
@@ -87,9 +279,54 @@ namespace casadi {
         casadi_error("Unknown operation" + str(e.op));
       }
     }
+    if (cat>=0) m->instr_ticks[cat] += Profiler::tick() - t0;
+    instr_profile_done(m);
     return 0;
   }
 
+  void SXFunction::set_instr_profile() {
+    std::vector<std::string> instr_name(algorithm_.size());
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      instr_name[k] = casadi_math<double>::name(algorithm_[k].op);
+    }
+    init_instr_profile(instr_name, std::vector<bool>(algorithm_.size(), false));
+  }
+
+  void SXFunction::set_compact_tape() {
+    compact_algorithm_.clear();
+    compact_constants_.clear();
+    if (!compact_tape_) return;
+
+    // Indices must fit in 16 bits
+    const casadi_int n_max = std::numeric_limits<unsigned short>::max();
+    if (worksize_>n_max+1 || n_in_>n_max+1 || n_out_>n_max+1) return;
+    for (casadi_int i=0; i<n_in_; ++i) if (nnz_in(i)>n_max+1) return;
+    for (casadi_int i=0; i<n_out_; ++i) if (nnz_out(i)>n_max+1) return;
+
+    compact_algorithm_.resize(algorithm_.size());
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      CompactEl& c = compact_algorithm_[k];
+      c.op = static_cast<unsigned short>(e.op);
+      c.i0 = static_cast<unsigned short>(e.i0);
+      if (e.op==OP_CONST) {
+        if (compact_constants_.size()>n_max) {
+          // Too many constants
+          compact_algorithm_.clear();
+          compact_constants_.clear();
+          return;
+        }
+        c.i1 = c.i2 = static_cast<unsigned short>(compact_constants_.size());
+        compact_constants_.push_back(e.d);
+      } else if (e.op==OP_PARAMETER) {
+        c.i1 = c.i2 = 0;
+      } else {
+        c.i1 = static_cast<unsigned short>(e.i1);
+        c.i2 = static_cast<unsigned short>(e.i2);
+      }
+    }
+  }
+
   bool SXFunction::is_smooth() const {
     // Go through all nodes and check if any node is non-smooth
     for (auto&& a : algorithm_) {
@@ -192,7 +429,22 @@ namespace casadi {
         "Just-in-time compilation for numeric evaluation using OpenCL (experimental)"}},
       {"live_variables",
        {OT_BOOL,
-        "Reuse variables in the work vector"}}
+        "Reuse variables in the work vector"}},
+      {"profile_instructions",
+       {OT_BOOL,
+        "Count executions and accumulate time per operation type during numerical "
+        "evaluation, reported as 'instructions' in the statistics and, "
+        "while the Profiler is active, in its call tree and trace [false]"}},
+      {"tape_ad",
+       {OT_BOOL,
+        "Evaluate forward and reverse directional derivatives numerically on the "
+        "algorithm, without constructing derivative expressions. Derivatives of these "
+        "functions are only available by finite differences [false]"}},
+      {"compact_tape",
+       {OT_BOOL,
+        "Evaluate numerically and propagate sparsity on a copy of the algorithm with "
+        "16-bit indices and the constants in a separate pool, when the work vector and "
+        "the dimensions permit [true]"}}
      }
   };
 
@@ -202,9 +454,39 @@ namespace casadi {
     opts["live_variables"] = live_variables_;
     opts["just_in_time_sparsity"] = just_in_time_sparsity_;
     opts["just_in_time_opencl"] = just_in_time_opencl_;
+    opts["profile_instructions"] = profile_instructions_;
+    opts["tape_ad"] = tape_ad_;
+    opts["compact_tape"] = compact_tape_;
     return opts;
   }
 
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+  void SXFunction::sort_depth_first(std::stack<SXNode*>& s, std::vector<SXNode*>& nodes,
+                                    std::unordered_map<const SXNode*, int>& temp) {
+    while (!s.empty()) {
+      // Get the topmost element
+      SXNode* t = s.top();
+      // Next dependency to be added, or -1 if the node has been added
+      int& t_temp = temp[t];
+      if (t_temp>=0) {
+        casadi_int next_dep = t_temp++;
+        if (next_dep < t->n_dep()) {
+          // Add dependency to stack
+          s.push(t->dep(next_dep).get());
+        } else {
+          // All dependencies added, add the node to the algorithm
+          nodes.push_back(t);
+          t_temp = -1;
+          s.pop();
+        }
+      } else {
+        // Already added
+        s.pop();
+      }
+    }
+  }
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+
   void SXFunction::init(const Dict& opts) {
     // Call the init function of the base class
     XFunction<SXFunction, SX, SXNode>::init(opts);
@@ -223,6 +505,12 @@ namespace casadi {
         just_in_time_opencl_ = op.second;
       } else if (op.first=="just_in_time_sparsity") {
         just_in_time_sparsity_ = op.second;
+      } else if (op.first=="profile_instructions") {
+        profile_instructions_ = op.second;
+      } else if (op.first=="tape_ad") {
+        tape_ad_ = op.second;
+      } else if (op.first=="compact_tape") {
+        compact_tape_ = op.second;
       }
     }
 
@@ -240,6 +528,14 @@ namespace casadi {
     // All nodes
     vector<SXNode*> nodes;
 
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Temporaries in a side table, nodes may be shared with graphs sorted by other threads
+    std::unordered_map<const SXNode*, int> temp;
+    auto tmp = [&temp](const SXNode* n) -> int& { return temp[n];};
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
+    auto tmp = [](const SXNode* n) -> int& { return n->temp;};
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+
     // Add the list of nodes
     casadi_int ind=0;
     for (auto it = out_.begin(); it != out_.end(); ++it, ++ind) {
@@ -247,7 +543,11 @@ namespace casadi {
       for (auto itc = (*it)->begin(); itc != (*it)->end(); ++itc, ++nz) {
         // Add outputs to the list
         s.push(itc->get());
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+        sort_depth_first(s, nodes, temp);
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
         sort_depth_first(s, nodes);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
 
         // A null pointer means an output instruction
         nodes.push_back(static_cast<SXNode*>(nullptr));
@@ -258,7 +558,7 @@ namespace casadi {
     // Set the temporary variables to be the corresponding place in the sorted graph
     for (casadi_int i=0; i<nodes.size(); ++i) {
       if (nodes[i]) {
-        nodes[i]->temp = static_cast<int>(i);
+        tmp(nodes[i]) = static_cast<int>(i);
       }
     }
 
@@ -307,16 +607,16 @@ namespace casadi {
       switch (ae.op) {
       case OP_CONST: // constant
         ae.d = n->to_double();
-        ae.i0 = n->temp;
+        ae.i0 = tmp(n);
         break;
       case OP_PARAMETER: // a parameter or input
         symb_loc.push_back(make_pair(algorithm_.size(), n));
-        ae.i0 = n->temp;
+        ae.i0 = tmp(n);
         ae.d = 0; // value not used, but set here to avoid uninitialized data in serialization
         break;
       case OP_OUTPUT: // output instruction
         ae.i0 = curr_oind;
-        ae.i1 = out_[curr_oind]->at(curr_nz)->temp;
+        ae.i1 = tmp(out_[curr_oind]->at(curr_nz).get());
         ae.i2 = curr_nz;
 
         // Go to the next nonzero
@@ -334,9 +634,9 @@ namespace casadi {
         }
         break;
       default:       // Unary or binary operation
-        ae.i0 = n->temp;
-        ae.i1 = n->dep(0).get()->temp;
-        ae.i2 = n->dep(1).get()->temp;
+        ae.i0 = tmp(n);
+        ae.i1 = tmp(n->dep(0).get());
+        ae.i2 = tmp(n->dep(1).get());
       }
 
       // Number of dependencies
@@ -418,13 +718,13 @@ namespace casadi {
     // Reset the temporary variables
     for (casadi_int i=0; i<nodes.size(); ++i) {
       if (nodes[i]) {
-        nodes[i]->temp = 0;
+        tmp(nodes[i]) = 0;
       }
     }
 
     // Now mark each input's place in the algorithm
     for (auto it=symb_loc.begin(); it!=symb_loc.end(); ++it) {
-      it->second->temp = it->first+1;
+      tmp(it->second) = it->first+1;
     }
 
     // Add input instructions
@@ -432,7 +732,7 @@ namespace casadi {
     for (int ind=0; ind<in_.size(); ++ind) {
       int nz=0;
       for (auto itc = in_[ind]->begin(); itc != in_[ind]->end(); ++itc, ++nz) {
-        int i = itc->get_temp()-1;
+        int i = tmp(itc->get())-1;
         if (i>=0) {
           // Mark as input
           algorithm_[i].op = OP_INPUT;
@@ -442,7 +742,7 @@ namespace casadi {
           algorithm_[i].i2 = nz;
 
           // Mark input as read
-          itc->set_temp(0);
+          tmp(itc->get()) = 0;
         }
       }
     }
@@ -451,12 +751,12 @@ namespace casadi {
     free_vars_.clear();
     for (vector<pair<int, SXNode*> >::const_iterator it=symb_loc.begin();
          it!=symb_loc.end(); ++it) {
-      if (it->second->temp!=0) {
+      if (tmp(it->second)!=0) {
         // Save to list of free parameters
         free_vars_.push_back(SXElem::create(it->second));
 
         // Remove marker
-        it->second->temp=0;
+        tmp(it->second) = 0;
       }
     }
 
@@ -470,6 +770,12 @@ namespace casadi {
       casadi_error("OpenCL is not supported in this version of CasADi");
     }
 
+    // Instruction categories for profiling
+    if (profile_instructions_) set_instr_profile();
+
+    // Compact copy of the algorithm
+    set_compact_tape();
+
     // Print
     if (verbose_) casadi_message(str(algorithm_.size()) + " elementary operations");
   }
@@ -629,30 +935,31 @@ namespace casadi {
       }
     }
 
-    // Work vector
-    vector<SXElem> w(worksize_);
-
-    // Calculate forward sensitivities
+    // Calculate forward sensitivities, directions may be split between threads
     if (verbose_) casadi_message("Calculating forward derivatives");
-    for (casadi_int dir=0; dir<nfwd; ++dir) {
-      vector<TapeEl<SXElem> >::const_iterator it2 = s_pdwork.begin();
-      for (auto&& a : algorithm_) {
-        switch (a.op) {
-        case OP_INPUT:
-          w[a.i0] = fseed[dir][a.i1].nonzeros()[a.i2]; break;
-        case OP_OUTPUT:
-          fsens[dir][a.i0].nonzeros()[a.i2] = w[a.i1]; break;
-        case OP_CONST:
-        case OP_PARAMETER:
-          w[a.i0] = 0;
-          break;
-          CASADI_MATH_BINARY_BUILTIN // Binary operation
-            w[a.i0] = it2->d[0] * w[a.i1] + it2->d[1] * w[a.i2];it2++;break;
-        default: // Unary operation
-          w[a.i0] = it2->d[0] * w[a.i1]; it2++;
+    for_directions(nfwd, [&](casadi_int d0, casadi_int d1) {
+      // Work vector
+      vector<SXElem> w(worksize_);
+      for (casadi_int dir=d0; dir<d1; ++dir) {
+        vector<TapeEl<SXElem> >::const_iterator it2 = s_pdwork.begin();
+        for (auto&& a : algorithm_) {
+          switch (a.op) {
+          case OP_INPUT:
+            w[a.i0] = fseed[dir][a.i1].nonzeros()[a.i2]; break;
+          case OP_OUTPUT:
+            fsens[dir][a.i0].nonzeros()[a.i2] = w[a.i1]; break;
+          case OP_CONST:
+          case OP_PARAMETER:
+            w[a.i0] = casadi_limits<SXElem>::zero;
+            break;
+            CASADI_MATH_BINARY_BUILTIN // Binary operation
+              w[a.i0] = it2->d[0] * w[a.i1] + it2->d[1] * w[a.i2];it2++;break;
+          default: // Unary operation
+            w[a.i0] = it2->d[0] * w[a.i1]; it2++;
+          }
         }
       }
-    }
+    });
   }
 
   void SXFunction::ad_reverse(const vector<vector<SX> >& aseed,
@@ -734,62 +1041,207 @@ namespace casadi {
     // Calculate adjoint sensitivities
     if (verbose_) casadi_message("Calculating adjoint derivatives");
 
-    // Work vector
-    vector<SXElem> w(worksize_, 0);
-
-    for (casadi_int dir=0; dir<nadj; ++dir) {
-      auto it2 = s_pdwork.rbegin();
-      for (auto it = algorithm_.rbegin(); it!=algorithm_.rend(); ++it) {
-        SXElem seed;
-        switch (it->op) {
-        case OP_INPUT:
-          asens[dir][it->i1].nonzeros()[it->i2] = w[it->i0];
-          w[it->i0] = 0;
-          break;
-        case OP_OUTPUT:
-          w[it->i1] += aseed[dir][it->i0].nonzeros()[it->i2];
-          break;
-        case OP_CONST:
-        case OP_PARAMETER:
-          w[it->i0] = 0;
-          break;
-          CASADI_MATH_BINARY_BUILTIN // Binary operation
+    // Directions may be split between threads
+    for_directions(nadj, [&](casadi_int d0, casadi_int d1) {
+      // Work vector
+      const SXElem& zero = casadi_limits<SXElem>::zero;
+      vector<SXElem> w(worksize_, zero);
+      for (casadi_int dir=d0; dir<d1; ++dir) {
+        auto it2 = s_pdwork.rbegin();
+        for (auto it = algorithm_.rbegin(); it!=algorithm_.rend(); ++it) {
+          SXElem seed;
+          switch (it->op) {
+          case OP_INPUT:
+            asens[dir][it->i1].nonzeros()[it->i2] = w[it->i0];
+            w[it->i0] = zero;
+            break;
+          case OP_OUTPUT:
+            w[it->i1] += aseed[dir][it->i0].nonzeros()[it->i2];
+            break;
+          case OP_CONST:
+          case OP_PARAMETER:
+            w[it->i0] = zero;
+            break;
+            CASADI_MATH_BINARY_BUILTIN // Binary operation
+              seed = w[it->i0];
+            w[it->i0] = zero;
+            w[it->i1] += it2->d[0] * seed;
+            w[it->i2] += it2->d[1] * seed;
+            it2++;
+            break;
+          default: // Unary operation
             seed = w[it->i0];
-          w[it->i0] = 0;
-          w[it->i1] += it2->d[0] * seed;
-          w[it->i2] += it2->d[1] * seed;
-          it2++;
-          break;
-        default: // Unary operation
-          seed = w[it->i0];
-          w[it->i0] = 0;
-          w[it->i1] += it2->d[0] * seed;
-          it2++;
+            w[it->i0] = zero;
+            w[it->i1] += it2->d[0] * seed;
+            it2++;
+          }
         }
       }
-    }
+    });
   }
 
-  int SXFunction::
-  sp_forward(const bvec_t** arg, bvec_t** res, casadi_int* iw, bvec_t* w, void* mem) const {
-    // Fall back when forward mode not allowed
-    if (sp_weight()==1) return FunctionInternal::sp_forward(arg, res, iw, w, mem);
-    // Propagate sparsity forward
-    for (auto&& e : algorithm_) {
-      switch (e.op) {
+  SX SXFunction::hess_edge_pushing(SX& g) const {
+    casadi_assert(n_in_==1 && n_out_==1 && sparsity_out_[0].is_scalar(),
+                  "Edge pushing requires a function with one input and a scalar output");
+    casadi_assert(!live_variables_, "Edge pushing requires 'live_variables' disabled");
+
+    // Input nonzero for each work vector element, or -1
+    vector<casadi_int> in_nz(worksize_, -1);
+
+    // Does a work vector element depend on the input?
+    vector<bool> active(worksize_, false);
+
+    // First order partial derivatives, as in ad_reverse
+    vector<TapeEl<SXElem> > s_pdwork(operations_.size());
+    vector<TapeEl<SXElem> >::iterator it1 = s_pdwork.begin();
+    vector<SXElem>::const_iterator b_it = operations_.begin();
+    for (auto&& a : algorithm_) {
+      switch (a.op) {
+      case OP_INPUT:
+        in_nz[a.i0] = a.i2;
+        active[a.i0] = true;
+        break;
+      case OP_OUTPUT:
       case OP_CONST:
       case OP_PARAMETER:
-        w[e.i0] = 0; break;
-      case OP_INPUT:
-        w[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2];
         break;
+      default:
+        {
+          const SXElem& f=*b_it++;
+          switch (a.op) {
+            CASADI_MATH_DER_BUILTIN(f->dep(0), f->dep(1), f, it1++->d)
+          }
+          active[a.i0] = active[a.i1] || active[a.i2];
+        }
+      }
+    }
+
+    // Second order partial derivatives, per operation type
+    std::map<casadi_int, SecondDerivatives> d2;
+
+    // Adjoints
+    vector<SXElem> adj(worksize_, 0);
+
+    // Nonlinear interactions between work vector elements, as symmetric adjacency lists
+    vector<std::map<casadi_int, SXElem> > W(worksize_);
+
+    // Reverse sweep
+    casadi_int k = operations_.size();
+    for (auto it = algorithm_.rbegin(); it!=algorithm_.rend(); ++it) {
+      switch (it->op) {
       case OP_OUTPUT:
-        if (res[e.i0]!=nullptr) res[e.i0][e.i2] = w[e.i1];
+        adj[it->i1] += 1;
         break;
-      default: // Unary or binary operation
-        w[e.i0] = w[e.i1] | w[e.i2]; break;
+      case OP_INPUT:
+      case OP_CONST:
+      case OP_PARAMETER:
+        break;
+      default:
+        {
+          const SXElem* d = s_pdwork[--k].d;
+          const SXElem& f = operations_[k];
+          casadi_int i = it->i0;
+          if (!active[i]) break;
+
+          // Second order partials of the operation
+          bool binary = casadi_math<SXElem>::is_binary(it->op);
+          SecondDerivatives& sd = d2[it->op];
+          if (sd.f.is_null()) sd.init(it->op);
+          if (!sd.zero) sd.eval(f->dep(0), binary ? f->dep(1) : f->dep(0));
+
+          // Distinct active dependencies with first and second order partials,
+          // the last entry of pd2 is the mixed partial
+          casadi_int nd = 0, dep[2];
+          SXElem pd[2], pd2[3];
+          if (binary && it->i1==it->i2) {
+            dep[nd] = it->i1;
+            pd[nd] = d[0] + d[1];
+            pd2[nd++] = sd.res[0] + 2*sd.res[1] + sd.res[2];
+          } else {
+            if (active[it->i1]) {
+              dep[nd] = it->i1;
+              pd[nd] = d[0];
+              pd2[nd++] = sd.res[0];
+            }
+            if (binary && active[it->i2]) {
+              dep[nd] = it->i2;
+              pd[nd] = d[1];
+              pd2[nd++] = sd.res[2];
+            }
+            pd2[2] = sd.res[1];
+          }
+
+          // Pushing: move the interactions of the result onto its dependencies
+          std::map<casadi_int, SXElem> Wi;
+          Wi.swap(W[i]);
+          for (auto&& e : Wi) {
+            casadi_int p = e.first;
+            if (p==i) {
+              for (casadi_int j=0; j<nd; ++j) add_sym(W, dep[j], dep[j], pd[j] * pd[j] * e.second);
+              if (nd==2) add_sym(W, dep[0], dep[1], pd[0] * pd[1] * e.second);
+            } else {
+              W[p].erase(i);
+              for (casadi_int j=0; j<nd; ++j) {
+                if (dep[j]==p) {
+                  add_sym(W, p, p, 2 * pd[j] * e.second);
+                } else {
+                  add_sym(W, dep[j], p, pd[j] * e.second);
+                }
+              }
+            }
+          }
+
+          // Creating: nonlinear interactions of the operation itself
+          if (!sd.zero && !adj[i].is_zero()) {
+            for (casadi_int j=0; j<nd; ++j) {
+              if (!pd2[j].is_zero()) add_sym(W, dep[j], dep[j], adj[i] * pd2[j]);
+            }
+            if (nd==2 && !pd2[2].is_zero()) add_sym(W, dep[0], dep[1], adj[i] * pd2[2]);
+          }
+
+          // Adjoints
+          for (casadi_int j=0; j<nd; ++j) adj[dep[j]] += pd[j] * adj[i];
+        }
+      }
+    }
+
+    // Gradient
+    vector<SXElem> g_nz(nnz_in(0), 0);
+    for (casadi_int p=0; p<worksize_; ++p) {
+      if (in_nz[p]>=0) g_nz[in_nz[p]] = adj[p];
+    }
+    g = SX(sparsity_in_[0], g_nz);
+
+    // Only interactions between inputs remain, map to elements of the input
+    const casadi_int* row = sparsity_in_[0].row();
+    vector<casadi_int> col = sparsity_in_[0].get_col();
+    casadi_int nrow = size1_in(0);
+    vector<casadi_int> h_row, h_col;
+    vector<SXElem> h_nz;
+    for (casadi_int p=0; p<worksize_; ++p) {
+      if (in_nz[p]<0) continue;
+      for (auto&& e : W[p]) {
+        casadi_int q = e.first;
+        casadi_assert_dev(in_nz[q]>=0);
+        h_row.push_back(row[in_nz[p]] + nrow*col[in_nz[p]]);
+        h_col.push_back(row[in_nz[q]] + nrow*col[in_nz[q]]);
+        h_nz.push_back(e.second);
       }
     }
+    casadi_int n = numel_in(0);
+    return SX::triplet(h_row, h_col, SX(h_nz), n, n);
+  }
+
+  int SXFunction::
+  sp_forward(const bvec_t** arg, bvec_t** res, casadi_int* iw, bvec_t* w, void* mem) const {
+    // Fall back when forward mode not allowed
+    if (sp_weight()==1) return FunctionInternal::sp_forward(arg, res, iw, w, mem);
+    // Propagate sparsity forward
+    if (compact_algorithm_.empty()) {
+      sp_forward_tape(algorithm_, arg, res, w);
+    } else {
+      sp_forward_tape(compact_algorithm_, arg, res, w);
+    }
     return 0;
   }
 
@@ -800,32 +1252,10 @@ namespace casadi {
     fill_n(w, sz_w(), 0);
 
     // Propagate sparsity backward
-    for (auto it=algorithm_.rbegin(); it!=algorithm_.rend(); ++it) {
-      // Temp seed
-      bvec_t seed;
-
-      // Propagate seeds
-      switch (it->op) {
-      case OP_CONST:
-      case OP_PARAMETER:
-        w[it->i0] = 0;
-        break;
-      case OP_INPUT:
-        if (arg[it->i1]!=nullptr) arg[it->i1][it->i2] |= w[it->i0];
-        w[it->i0] = 0;
-        break;
-      case OP_OUTPUT:
-        if (res[it->i0]!=nullptr) {
-          w[it->i1] |= res[it->i0][it->i2];
-          res[it->i0][it->i2] = 0;
-        }
-        break;
-      default: // Unary or binary operation
-        seed = w[it->i0];
-        w[it->i0] = 0;
-        w[it->i1] |= seed;
-        w[it->i2] |= seed;
-      }
+    if (compact_algorithm_.empty()) {
+      sp_reverse_tape(algorithm_, arg, res, w);
+    } else {
+      sp_reverse_tape(compact_algorithm_, arg, res, w);
     }
     return 0;
   }
@@ -850,6 +1280,204 @@ namespace casadi {
     return Function(name, ret_in, {J}, inames, onames, opts);
   }
 
+  Dict SXFunction::tape_options(const Dict& opts) {
+    // Drop the options that only apply to expression graph functions
+    Dict ret;
+    for (auto&& op : opts) {
+      if (FunctionInternal::options_.find(op.first)) ret.insert(op);
+    }
+    return ret;
+  }
+
+  Function SXFunction::get_forward(casadi_int nfwd, const std::string& name,
+                                   const std::vector<std::string>& inames,
+                                   const std::vector<std::string>& onames,
+                                   const Dict& opts) const {
+    if (!tape_ad_) {
+      return XFunction<SXFunction, SX, SXNode>::get_forward(nfwd, name, inames, onames, opts);
+    }
+    return Function::create(new TapeForward(name, nfwd), tape_options(opts));
+  }
+
+  Function SXFunction::get_reverse(casadi_int nadj, const std::string& name,
+                                   const std::vector<std::string>& inames,
+                                   const std::vector<std::string>& onames,
+                                   const Dict& opts) const {
+    if (!tape_ad_) {
+      return XFunction<SXFunction, SX, SXNode>::get_reverse(nadj, name, inames, onames, opts);
+    }
+    return Function::create(new TapeReverse(name, nadj), tape_options(opts));
+  }
+
+  size_t SXFunction::sz_tape_fwd(casadi_int nfwd) const {
+    // Values, followed by nfwd directional derivatives per work vector element
+    return worksize_ * (1 + nfwd);
+  }
+
+  size_t SXFunction::sz_tape_adj(casadi_int nadj) const {
+    // Values, two partial derivatives per operation, nadj adjoints per work vector element
+    return worksize_ * (1 + nadj) + 2 * operations_.size();
+  }
+
+  int SXFunction::eval_tape_fwd(const double** arg, double** res, double* w,
+      casadi_int nfwd) const {
+    // Make sure no free parameters
+    if (!free_vars_.empty()) {
+      casadi_error("Cannot evaluate \"" + name_ + "\" since variables "
+                   + str(free_vars_) + " are free.");
+    }
+
+    // Seeds and sensitivities
+    const double** fseed = arg + n_in_ + n_out_;
+    double** fsens = res;
+
+    // Directional derivatives, stored after the values
+    double* t = w + worksize_;
+    double f, d[2];
+    casadi_int k;
+    for (auto&& e : algorithm_) {
+      double* t0 = t + e.i0 * nfwd;
+      switch (e.op) {
+      case OP_CONST:
+        w[e.i0] = e.d;
+        for (k=0; k<nfwd; ++k) t0[k] = 0;
+        break;
+      case OP_INPUT:
+        w[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2];
+        if (fseed[e.i1]==nullptr) {
+          for (k=0; k<nfwd; ++k) t0[k] = 0;
+        } else {
+          casadi_int nnz = nnz_in(e.i1);
+          for (k=0; k<nfwd; ++k) t0[k] = fseed[e.i1][e.i2 + k*nnz];
+        }
+        break;
+      case OP_OUTPUT:
+        if (fsens[e.i0]!=nullptr) {
+          const double* t1 = t + e.i1 * nfwd;
+          casadi_int nnz = nnz_out(e.i0);
+          for (k=0; k<nfwd; ++k) fsens[e.i0][e.i2 + k*nnz] = t1[k];
+        }
+        break;
+      default:
+        {
+          // Value and partial derivatives, before the result may overwrite an argument
+          switch (e.op) {
+            CASADI_MATH_FUN_BUILTIN(w[e.i1], w[e.i2], f)
+          }
+          switch (e.op) {
+            CASADI_MATH_DER_BUILTIN(w[e.i1], w[e.i2], f, d)
+          }
+          w[e.i0] = f;
+          // Chain rule, for all directions
+          const double *t1 = t + e.i1 * nfwd, *t2 = t + e.i2 * nfwd;
+          switch (e.op) {
+            CASADI_MATH_BINARY_BUILTIN // Binary operation
+              for (k=0; k<nfwd; ++k) t0[k] = d[0] * t1[k] + d[1] * t2[k];
+              break;
+            default: // Unary operation
+              for (k=0; k<nfwd; ++k) t0[k] = d[0] * t1[k];
+          }
+        }
+      }
+    }
+    return 0;
+  }
+
+  int SXFunction::eval_tape_adj(const double** arg, double** res, double* w,
+      casadi_int nadj) const {
+    // Make sure no free parameters
+    if (!free_vars_.empty()) {
+      casadi_error("Cannot evaluate \"" + name_ + "\" since variables "
+                   + str(free_vars_) + " are free.");
+    }
+
+    // Seeds and sensitivities
+    const double** aseed = arg + n_in_ + n_out_;
+    double** asens = res;
+
+    // Partial derivatives and adjoints, stored after the values
+    double* pd = w + worksize_;
+    double* a = pd + 2 * operations_.size();
+
+    // Forward sweep, recording the partial derivatives
+    double f, *d = pd;
+    for (auto&& e : algorithm_) {
+      switch (e.op) {
+      case OP_CONST:
+        w[e.i0] = e.d;
+        break;
+      case OP_INPUT:
+        w[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2];
+        break;
+      case OP_OUTPUT:
+        break;
+      default:
+        switch (e.op) {
+          CASADI_MATH_FUN_BUILTIN(w[e.i1], w[e.i2], f)
+        }
+        switch (e.op) {
+          CASADI_MATH_DER_BUILTIN(w[e.i1], w[e.i2], f, d)
+        }
+        w[e.i0] = f;
+        d += 2;
+      }
+    }
+
+    // Inputs not in the algorithm have zero sensitivities
+    for (casadi_int i=0; i<n_in_; ++i) {
+      if (asens[i]!=nullptr) casadi_clear(asens[i], nnz_in(i) * nadj);
+    }
+
+    // Reverse sweep
+    casadi_clear(a, worksize_ * nadj);
+    casadi_int k;
+    for (auto it = algorithm_.rbegin(); it!=algorithm_.rend(); ++it) {
+      double* a0 = a + it->i0 * nadj;
+      switch (it->op) {
+      case OP_CONST:
+        for (k=0; k<nadj; ++k) a0[k] = 0;
+        break;
+      case OP_INPUT:
+        if (asens[it->i1]!=nullptr) {
+          casadi_int nnz = nnz_in(it->i1);
+          for (k=0; k<nadj; ++k) asens[it->i1][it->i2 + k*nnz] = a0[k];
+        }
+        for (k=0; k<nadj; ++k) a0[k] = 0;
+        break;
+      case OP_OUTPUT:
+        if (aseed[it->i0]!=nullptr) {
+          double* a1 = a + it->i1 * nadj;
+          casadi_int nnz = nnz_out(it->i0);
+          for (k=0; k<nadj; ++k) a1[k] += aseed[it->i0][it->i2 + k*nnz];
+        }
+        break;
+      default:
+        {
+          d -= 2;
+          double *a1 = a + it->i1 * nadj, *a2 = a + it->i2 * nadj;
+          double seed;
+          switch (it->op) {
+            CASADI_MATH_BINARY_BUILTIN // Binary operation
+              for (k=0; k<nadj; ++k) {
+                seed = a0[k];
+                a0[k] = 0;
+                a1[k] += d[0] * seed;
+                a2[k] += d[1] * seed;
+              }
+              break;
+            default: // Unary operation
+              for (k=0; k<nadj; ++k) {
+                seed = a0[k];
+                a0[k] = 0;
+                a1[k] += d[0] * seed;
+              }
+          }
+        }
+      }
+    }
+    return 0;
+  }
+
   const SX SXFunction::sx_in(casadi_int ind) const {
     return in_.at(ind);
   }
@@ -965,7 +1593,7 @@ namespace casadi {
 
   SXFunction::SXFunction(DeserializingStream& s) :
     XFunction<SXFunction, SX, SXNode>(s) {
-    s.version("SXFunction", 1);
+    int version = s.version("SXFunction", 1, 4);
     size_t n_instructions;
     s.unpack("SXFunction::n_instr", n_instructions);
 
@@ -989,13 +1617,31 @@ namespace casadi {
     just_in_time_sparsity_ = false;
 
     s.unpack("SXFunction::live_variables", live_variables_);
+    if (version >= 2) {
+      s.unpack("SXFunction::profile_instructions", profile_instructions_);
+    } else {
+      profile_instructions_ = false;
+    }
+    if (version >= 3) {
+      s.unpack("SXFunction::tape_ad", tape_ad_);
+    } else {
+      tape_ad_ = false;
+    }
+    if (version >= 4) {
+      s.unpack("SXFunction::compact_tape", compact_tape_);
+    } else {
+      compact_tape_ = true;
+    }
 
     XFunction<SXFunction, SX, SXNode>::delayed_deserialize_members(s);
+
+    if (profile_instructions_) set_instr_profile();
+    set_compact_tape();
   }
 
   void SXFunction::serialize_body(SerializingStream &s) const {
     XFunction<SXFunction, SX, SXNode>::serialize_body(s);
-    s.version("SXFunction", 1);
+    s.version("SXFunction", 4);
     s.pack("SXFunction::n_instr", algorithm_.size());
 
     s.pack("SXFunction::worksize", worksize_);
@@ -1013,6 +1659,9 @@ namespace casadi {
     }
 
     s.pack("SXFunction::live_variables", live_variables_);
+    s.pack("SXFunction::profile_instructions", profile_instructions_);
+    s.pack("SXFunction::tape_ad", tape_ad_);
+    s.pack("SXFunction::compact_tape", compact_tape_);
 
     XFunction<SXFunction, SX, SXNode>::delayed_serialize_members(s);
   }
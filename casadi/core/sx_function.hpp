@@ -79,6 +79,14 @@ class CASADI_EXPORT SXFunction :
   void ad_reverse(const std::vector<std::vector<SX> >& aseed,
                             std::vector<std::vector<SX> >& asens) const;
 
+  /** \brief Hessian of a scalar output by edge pushing
+
+      A single reverse sweep over the algorithm propagating the nonlinear interactions
+      between work vector elements. Requires one input and live_variables disabled.
+      The gradient is returned in \a g.
+  */
+  SX hess_edge_pushing(SX& g) const;
+
   /** \brief  Check if smooth */
   bool is_smooth() const;
 
@@ -167,6 +175,17 @@ class CASADI_EXPORT SXFunction :
   /** \brief  all binary nodes of the tree in the order of execution */
   std::vector<AlgEl> algorithm_;
 
+  /** \brief  An element of the compact algorithm, constants are kept in a pool */
+  struct CompactEl {
+    unsigned short op, i0, i1, i2;
+  };
+
+  /** \brief  The algorithm with 16-bit indices, empty if they do not fit */
+  std::vector<CompactEl> compact_algorithm_;
+
+  /** \brief  Constants of the compact algorithm */
+  std::vector<double> compact_constants_;
+
   // Work vector size
   size_t worksize_;
 
@@ -219,6 +238,43 @@ class CASADI_EXPORT SXFunction :
                                    const std::vector<std::string>& onames,
                                    const Dict& opts) const override;
 
+  ///@{
+  /** \brief Generate a function that calculates \a nfwd forward derivatives */
+  Function get_forward(casadi_int nfwd, const std::string& name,
+                       const std::vector<std::string>& inames,
+                       const std::vector<std::string>& onames,
+                       const Dict& opts) const override;
+  ///@}
+
+  ///@{
+  /** \brief Generate a function that calculates \a nadj adjoint derivatives */
+  Function get_reverse(casadi_int nadj, const std::string& name,
+                       const std::vector<std::string>& inames,
+                       const std::vector<std::string>& onames,
+                       const Dict& opts) const override;
+  ///@}
+
+  ///@{
+  /** \brief Work vector size for directional derivatives evaluated on the algorithm */
+  size_t sz_tape_fwd(casadi_int nfwd) const;
+  size_t sz_tape_adj(casadi_int nadj) const;
+  ///@}
+
+  /** \brief Evaluate forward directional derivatives numerically on the algorithm
+
+      Inputs and outputs are laid out as in the function returned by get_forward.
+  */
+  int eval_tape_fwd(const double** arg, double** res, double* w, casadi_int nfwd) const;
+
+  /** \brief Evaluate adjoint directional derivatives numerically on the algorithm
+
+      Inputs and outputs are laid out as in the function returned by get_reverse.
+  */
+  int eval_tape_adj(const double** arg, double** res, double* w, casadi_int nadj) const;
+
+  /** \brief Options for a function evaluating directional derivatives on the algorithm */
+  static Dict tape_options(const Dict& opts);
+
   /** *\brief get SX expression associated with instructions */
   SX instructions_sx() const override;
 
@@ -238,6 +294,33 @@ class CASADI_EXPORT SXFunction :
   /// Live variables?
   bool live_variables_;
 
+  /// Profile instructions?
+  bool profile_instructions_;
+
+  /// Directional derivatives evaluated on the algorithm?
+  bool tape_ad_;
+
+  /// Evaluate on the compact algorithm when possible?
+  bool compact_tape_;
+
+  /** \brief Set up the compact algorithm */
+  void set_compact_tape();
+
+  /** \brief Evaluate numerically, with instruction profiling */
+  int eval_profile(const double** arg, double** res, double* w, void* mem) const;
+
+  /** \brief Set up instruction categories for profiling */
+  void set_instr_profile();
+
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+  /** \brief Topological sorting as sort_depth_first, marking nodes in a side table
+
+      The temporaries of nodes shared with other threads cannot be used.
+  */
+  static void sort_depth_first(std::stack<SXNode*>& s, std::vector<SXNode*>& nodes,
+                               std::unordered_map<const SXNode*, int>& temp);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+
 protected:
   /** \brief Deserializing constructor */
   explicit SXFunction(DeserializingStream& s);
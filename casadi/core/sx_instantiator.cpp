@@ -27,6 +27,8 @@
 
 #include "sx_function.hpp"
 
+#include <unordered_set>
+
 using namespace std;
 
 namespace casadi {
@@ -166,22 +168,37 @@ namespace casadi {
     return scalar().is_op(op);
   }
 
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+  // Marks set by has_duplicates, per thread since symbols may be shared between threads
+  static thread_local std::unordered_set<const SXNode*> input_marks;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+
   template<> bool CASADI_EXPORT SX::has_duplicates() const {
     bool has_duplicates = false;
     for (auto&& i : nonzeros_) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      bool is_duplicate = !input_marks.insert(i.get()).second;
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
       bool is_duplicate = i.get_temp()!=0;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
       if (is_duplicate) {
         casadi_warning("Duplicate expression: " + str(i));
       }
       has_duplicates = has_duplicates || is_duplicate;
+#ifndef CASADI_WITH_THREADSAFE_SYMBOLICS
       i.set_temp(1);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     }
     return has_duplicates;
   }
 
   template<> void CASADI_EXPORT SX::reset_input() const {
     for (auto&& i : nonzeros_) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      input_marks.erase(i.get());
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
       i.set_temp(0);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
     }
   }
 
@@ -578,6 +595,22 @@ namespace casadi {
   template<>
   SX CASADI_EXPORT SX::hessian(const SX &ex, const SX &arg, SX &g, const Dict& opts) {
     Dict all_opts = opts;
+    // Edge pushing on the algorithm instead of a symmetric Jacobian of the gradient
+    auto ep = all_opts.find("edge_pushing");
+    if (ep!=all_opts.end()) {
+      bool edge_pushing = ep->second;
+      all_opts.erase(ep);
+      if (edge_pushing) {
+        Dict h_opts;
+        Dict opts_remainder = extract_from_dict(all_opts, "helper_options", h_opts);
+        for (auto&& op : opts_remainder) {
+          if (op.first!="verbose") casadi_error("No such option for edge pushing: " + op.first);
+        }
+        h_opts["live_variables"] = false;
+        Function h("hess_helper", {arg}, {ex}, h_opts);
+        return h.get<SXFunction>()->hess_edge_pushing(g);
+      }
+    }
     if (!opts.count("symmetric")) all_opts["symmetric"] = true;
     g = gradient(ex, arg);
     return jacobian(g, arg, all_opts);
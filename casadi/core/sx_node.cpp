@@ -30,6 +30,7 @@
 #include "constant_sx.hpp"
 #include "symbolic_sx.hpp"
 
+#include <cstdint>
 #include <limits>
 #include <stack>
 
@@ -155,7 +156,7 @@ namespace casadi {
 
   void SXNode::safe_delete(SXNode* n) {
     // Quick return if more owners
-    if (n->count>0) return;
+    if (n==nullptr || n->count>0) return;
     // Delete straight away if it doesn't have any dependencies
     if (!n->n_dep()) {
       delete n;
@@ -164,6 +165,7 @@ namespace casadi {
     // Stack of expressions to be deleted
     std::stack<SXNode*> deletion_stack;
     // Add the node to the deletion stack
+    n->uncache();
     deletion_stack.push(n);
     // Process stack
     while (!deletion_stack.empty()) {
@@ -175,14 +177,15 @@ namespace casadi {
         // Get the node of the dependency of the top element
         // and remove it from the smart pointer
         SXNode *n2 = t->dep(c2).assignNoDelete(casadi_limits<SXElem>::nan);
-        // Check if this is the only reference to the element
-        if (n2->count == 0) {
+        // Check if this was the only reference to the element
+        if (n2 != nullptr) {
           // Check if unary or binary
           if (!n2->n_dep()) {
             // Delete straight away if not binary
             delete n2;
           } else {
             // Add to deletion stack
+            n2->uncache();
             deletion_stack.push(n2);
             added_to_stack = true;
           }
@@ -226,6 +229,67 @@ namespace casadi {
   }
 
 
+  SXNodeTable::SXNodeTable() : entries_(64, Entry{SXNodeKey{0, nullptr, nullptr}, nullptr}),
+      size_(0) {
+  }
+
+  size_t SXNodeTable::hash(const SXNodeKey& key) {
+    uint64_t a = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key.dep0));
+    uint64_t b = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key.dep1));
+    uint64_t h = a * 0x9E3779B97F4A7C15ULL;
+    h ^= (b + static_cast<uint64_t>(key.op)) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 29;
+    return static_cast<size_t>(h);
+  }
+
+  size_t SXNodeTable::slot(const SXNodeKey& key) const {
+    size_t mask = entries_.size()-1;
+    size_t i = hash(key) & mask;
+    while (entries_[i].node!=nullptr && !(entries_[i].key==key)) i = (i+1) & mask;
+    return i;
+  }
+
+  SXNode* SXNodeTable::find(const SXNodeKey& key) const {
+    return entries_[slot(key)].node;
+  }
+
+  void SXNodeTable::set(const SXNodeKey& key, SXNode* n) {
+    size_t i = slot(key);
+    if (entries_[i].node==nullptr) {
+      // Keep the load factor below 1/2
+      if (2*(size_+1) > entries_.size()) {
+        std::vector<Entry> old(2*entries_.size(), Entry{SXNodeKey{0, nullptr, nullptr}, nullptr});
+        old.swap(entries_);
+        for (const Entry& e : old) {
+          if (e.node!=nullptr) entries_[slot(e.key)] = e;
+        }
+        i = slot(key);
+      }
+      size_++;
+    }
+    entries_[i].key = key;
+    entries_[i].node = n;
+  }
+
+  void SXNodeTable::erase(const SXNodeKey& key, const SXNode* n) {
+    size_t i = slot(key);
+    if (entries_[i].node!=n || n==nullptr) return;
+    size_--;
+    // Shift back later entries of the probe sequence, no tombstones needed
+    size_t mask = entries_.size()-1;
+    size_t j = i;
+    while (true) {
+      j = (j+1) & mask;
+      if (entries_[j].node==nullptr) break;
+      size_t k = hash(entries_[j].key) & mask;
+      // Move if the home slot k does not lie cyclically in (i, j]
+      if ((i<=j) ? (i<k && k<=j) : (i<k || k<=j)) continue;
+      entries_[i] = entries_[j];
+      i = j;
+    }
+    entries_[i].node = nullptr;
+  }
+
   // Note: binary/unary operations are ommitted here
   std::map<casadi_int, SXNode* (*)(DeserializingStream&)> SXNode::deserialize_map = {
     {OP_PARAMETER, SymbolicSX::deserialize},
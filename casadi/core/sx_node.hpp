@@ -30,14 +30,75 @@
 #include <math.h>
 #include <sstream>
 #include <string>
+#include <vector>
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+#include <atomic>
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
 
 /** \brief  Scalar expression (which also works as a smart pointer class to this class) */
 #include "sx_elem.hpp"
+#include "node_pool.hpp"
 
 
 /// \cond INTERNAL
 namespace casadi {
 
+  class SXNode;
+
+  /** \brief Key of an operation node in the hash-consing table */
+  struct SXNodeKey {
+    casadi_int op;
+    const SXNode *dep0, *dep1;
+    bool operator==(const SXNodeKey& k) const {
+      return op==k.op && dep0==k.dep0 && dep1==k.dep1;
+    }
+  };
+
+  /** \brief Hash-consing table, open addressing with linear probing
+
+      Keys are stored next to the node pointers, so that probing does not touch the nodes.
+  */
+  class CASADI_EXPORT SXNodeTable {
+  public:
+    /// Constructor
+    SXNodeTable();
+
+    /// Find the node with a given key, null if none
+    SXNode* find(const SXNodeKey& key) const;
+
+    /// Insert a node, replacing any node with the same key
+    void set(const SXNodeKey& key, SXNode* n);
+
+    /// Remove the entry with a given key, if it refers to the node n
+    void erase(const SXNodeKey& key, const SXNode* n);
+
+    /// Number of entries
+    size_t size() const { return size_;}
+
+  private:
+    struct Entry {
+      SXNodeKey key;
+      SXNode* node;
+    };
+
+    // Hash function
+    static size_t hash(const SXNodeKey& key);
+
+    // Slot of a key, or of the empty slot ending its probe sequence
+    size_t slot(const SXNodeKey& key) const;
+
+    // Entries, number of slots is a power of two
+    std::vector<Entry> entries_;
+
+    // Number of entries in use
+    size_t size_;
+  };
+
   /** \brief  Internal node class for SX
       \author Joel Andersson
       \date 2010
@@ -54,6 +115,14 @@ namespace casadi {
     /** \brief  destructor  */
     virtual ~SXNode();
 
+#ifdef CASADI_WITH_NODE_POOL
+    ///@{
+    /** \brief  Allocate from the node pool */
+    static void* operator new(std::size_t sz) { return NodePool::allocate(sz);}
+    static void operator delete(void* p, std::size_t sz) { NodePool::deallocate(p, sz);}
+    ///@}
+#endif // CASADI_WITH_NODE_POOL
+
     ///@{
     /** \brief  check properties of a node */
     virtual bool is_constant() const { return false; }
@@ -121,6 +190,12 @@ namespace casadi {
     /** \brief Non-recursive delete */
     static void safe_delete(SXNode* n);
 
+    /** \brief Remove from the hash-consing table, before the dependencies are released */
+    virtual void uncache() {}
+
+    /** \brief Hash-consed operation nodes, see GlobalOptions::hash_consing */
+    static SXNodeTable cached_nodes_;
+
     // Depth when checking equalities
     static casadi_int eq_depth_;
 
@@ -131,7 +206,19 @@ namespace casadi {
     mutable int temp;
 
     // Reference counter -- counts the number of parents of the node
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    std::atomic<unsigned int> count;
+
+    /** \brief Guards the constant and hash-consing caches
+
+        A cached node whose count is zero is being deleted by another thread and
+        must not be reused. Lookups therefore increment the count of the node they
+        return before the lock is released.
+    */
+    static std::recursive_mutex cache_mtx_;
+#else // CASADI_WITH_THREADSAFE_SYMBOLICS
     unsigned int count;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
 
     /** \brief Serialize an object */
     void serialize(SerializingStream& s) const;
@@ -0,0 +1,166 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "tape_ad.hpp"
+#include "sx_function.hpp"
+
+using namespace std;
+
+namespace casadi {
+
+  TapeAD::TapeAD(const std::string& name, casadi_int n)
+    : FunctionInternal(name), n_(n), f_(nullptr) {
+  }
+
+  TapeAD::~TapeAD() {
+    clear_mem();
+  }
+
+  void TapeAD::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // The differentiated function
+    f_ = derivative_of_.get<SXFunction>();
+    casadi_assert(f_!=nullptr, "'" + class_name() + "' requires an SXFunction");
+  }
+
+  double TapeAD::get_default_in(casadi_int ind) const {
+    if (ind<derivative_of_.n_in()) {
+      return derivative_of_.default_in(ind);
+    } else {
+      return 0;
+    }
+  }
+
+  size_t TapeForward::get_n_in() {
+    return derivative_of_.n_in() + derivative_of_.n_out() + derivative_of_.n_in();
+  }
+
+  size_t TapeForward::get_n_out() {
+    return derivative_of_.n_out();
+  }
+
+  Sparsity TapeForward::get_sparsity_in(casadi_int i) {
+    casadi_int n_in = derivative_of_.n_in(), n_out = derivative_of_.n_out();
+    if (i<n_in) {
+      // Non-differentiated input
+      return derivative_of_.sparsity_in(i);
+    } else if (i<n_in+n_out) {
+      // Non-differentiated output, not used
+      return Sparsity(derivative_of_.size_out(i-n_in));
+    } else {
+      // Seeds
+      return repmat(derivative_of_.sparsity_in(i-n_in-n_out), 1, n_);
+    }
+  }
+
+  Sparsity TapeForward::get_sparsity_out(casadi_int i) {
+    return repmat(derivative_of_.sparsity_out(i), 1, n_);
+  }
+
+  std::string TapeForward::get_name_in(casadi_int i) {
+    casadi_int n_in = derivative_of_.n_in(), n_out = derivative_of_.n_out();
+    if (i<n_in) {
+      return derivative_of_.name_in(i);
+    } else if (i<n_in+n_out) {
+      return "out_" + derivative_of_.name_out(i-n_in);
+    } else {
+      return "fwd_" + derivative_of_.name_in(i-n_in-n_out);
+    }
+  }
+
+  std::string TapeForward::get_name_out(casadi_int i) {
+    return "fwd_" + derivative_of_.name_out(i);
+  }
+
+  void TapeForward::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    TapeAD::init(opts);
+
+    // Work vector for the values and the directional derivatives
+    alloc_w(f_->sz_tape_fwd(n_), true);
+  }
+
+  int TapeForward::eval(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    return f_->eval_tape_fwd(arg, res, w, n_);
+  }
+
+  size_t TapeReverse::get_n_in() {
+    return derivative_of_.n_in() + derivative_of_.n_out() + derivative_of_.n_out();
+  }
+
+  size_t TapeReverse::get_n_out() {
+    return derivative_of_.n_in();
+  }
+
+  Sparsity TapeReverse::get_sparsity_in(casadi_int i) {
+    casadi_int n_in = derivative_of_.n_in(), n_out = derivative_of_.n_out();
+    if (i<n_in) {
+      // Non-differentiated input
+      return derivative_of_.sparsity_in(i);
+    } else if (i<n_in+n_out) {
+      // Non-differentiated output, not used
+      return Sparsity(derivative_of_.size_out(i-n_in));
+    } else {
+      // Seeds
+      return repmat(derivative_of_.sparsity_out(i-n_in-n_out), 1, n_);
+    }
+  }
+
+  Sparsity TapeReverse::get_sparsity_out(casadi_int i) {
+    return repmat(derivative_of_.sparsity_in(i), 1, n_);
+  }
+
+  std::string TapeReverse::get_name_in(casadi_int i) {
+    casadi_int n_in = derivative_of_.n_in(), n_out = derivative_of_.n_out();
+    if (i<n_in) {
+      return derivative_of_.name_in(i);
+    } else if (i<n_in+n_out) {
+      return "out_" + derivative_of_.name_out(i-n_in);
+    } else {
+      return "adj_" + derivative_of_.name_out(i-n_in-n_out);
+    }
+  }
+
+  std::string TapeReverse::get_name_out(casadi_int i) {
+    return "adj_" + derivative_of_.name_in(i);
+  }
+
+  void TapeReverse::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    TapeAD::init(opts);
+
+    // Work vector for the values, the partial derivatives and the adjoints
+    alloc_w(f_->sz_tape_adj(n_), true);
+  }
+
+  int TapeReverse::eval(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    return f_->eval_tape_adj(arg, res, w, n_);
+  }
+
+} // namespace casadi
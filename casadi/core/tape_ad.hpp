@@ -0,0 +1,138 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_TAPE_AD_HPP
+#define CASADI_TAPE_AD_HPP
+
+#include "function_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+  class SXFunction;
+
+  /** Directional derivatives evaluated numerically on the algorithm of an SXFunction,
+    * without constructing derivative expressions (option "tape_ad")
+  */
+  class CASADI_EXPORT TapeAD : public FunctionInternal {
+  public:
+    // Constructor (protected, use create function)
+    TapeAD(const std::string& name, casadi_int n);
+
+    /** \brief Destructor */
+    ~TapeAD() override;
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    /** \brief Get default input value */
+    double get_default_in(casadi_int ind) const override;
+
+  protected:
+    // Number of directional derivatives
+    casadi_int n_;
+
+    // The differentiated function
+    const SXFunction* f_;
+  };
+
+  /** Forward mode on the algorithm of an SXFunction */
+  class CASADI_EXPORT TapeForward : public TapeAD {
+  public:
+    // Constructor
+    TapeForward(const std::string& name, casadi_int n) : TapeAD(name, n) {}
+
+    /** \brief Destructor */
+    ~TapeForward() override {}
+
+    /** \brief Get type name */
+    std::string class_name() const override {return "TapeForward";}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs */
+    Sparsity get_sparsity_in(casadi_int i) override;
+    Sparsity get_sparsity_out(casadi_int i) override;
+    /// @}
+
+    ///@{
+    /** \brief Number of function inputs and outputs */
+    size_t get_n_in() override;
+    size_t get_n_out() override;
+    ///@}
+
+    ///@{
+    /** \brief Names of function input and outputs */
+    std::string get_name_in(casadi_int i) override;
+    std::string get_name_out(casadi_int i) override;
+    ///@}
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    // Evaluate numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+  };
+
+  /** Reverse mode on the algorithm of an SXFunction */
+  class CASADI_EXPORT TapeReverse : public TapeAD {
+  public:
+    // Constructor
+    TapeReverse(const std::string& name, casadi_int n) : TapeAD(name, n) {}
+
+    /** \brief Destructor */
+    ~TapeReverse() override {}
+
+    /** \brief Get type name */
+    std::string class_name() const override {return "TapeReverse";}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs */
+    Sparsity get_sparsity_in(casadi_int i) override;
+    Sparsity get_sparsity_out(casadi_int i) override;
+    /// @}
+
+    ///@{
+    /** \brief Number of function inputs and outputs */
+    size_t get_n_in() override;
+    size_t get_n_out() override;
+    ///@}
+
+    ///@{
+    /** \brief Names of function input and outputs */
+    std::string get_name_in(casadi_int i) override;
+    std::string get_name_out(casadi_int i) override;
+    ///@}
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    // Evaluate numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_TAPE_AD_HPP
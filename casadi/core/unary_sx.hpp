@@ -28,6 +28,7 @@
 
 #include "sx_node.hpp"
 #include "serializing_stream.hpp"
+#include "global_options.hpp"
 
 /// \cond INTERNAL
 
@@ -41,7 +42,7 @@ class UnarySX : public SXNode {
   private:
 
     /** \brief  Constructor is private, use "create" below */
-    UnarySX(unsigned char op, const SXElem& dep) : op_(op), dep_(dep) {}
+    UnarySX(unsigned char op, const SXElem& dep) : op_(op), cached_(false), dep_(dep) {}
 
   public:
 
@@ -53,6 +54,18 @@ class UnarySX : public SXNode {
         double ret_val;
         casadi_math<double>::fun(op, dep_val, dep_val, ret_val);
         return ret_val;
+      } else if (GlobalOptions::hash_consing) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+        std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+        // Reuse an identical node if there is one, unless being deleted by another thread
+        SXNodeKey key{op, dep.get(), nullptr};
+        SXNode* c = cached_nodes_.find(key);
+        if (c!=nullptr && c->count!=0) return SXElem::create(c);
+        UnarySX* n = new UnarySX(op, dep);
+        n->cached_ = true;
+        cached_nodes_.set(key, n);
+        return SXElem::create(n);
       } else {
         // Expression containing free variables
         return SXElem::create(new UnarySX(op, dep));
@@ -61,9 +74,22 @@ class UnarySX : public SXNode {
 
     /** \brief Destructor */
     ~UnarySX() override {
+      uncache();
       safe_delete(dep_.assignNoDelete(casadi_limits<SXElem>::nan));
     }
 
+    /** \brief Remove from the hash-consing table */
+    void uncache() override {
+      if (cached_) {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+        std::lock_guard<std::recursive_mutex> lock(cache_mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+        // The entry may already refer to a replacement
+        cached_nodes_.erase(SXNodeKey{op_, dep_.get(), nullptr}, this);
+        cached_ = false;
+      }
+    }
+
     // Class name
     std::string class_name() const override {return "UnarySX";}
 
@@ -95,6 +121,9 @@ class UnarySX : public SXNode {
     /** \brief  The binary operation as an 1 byte integer (allows 256 values) */
     unsigned char op_;
 
+    /** \brief  Is the node in the hash-consing table */
+    bool cached_;
+
     /** \brief  The dependencies of the node */
     SXElem dep_;
 
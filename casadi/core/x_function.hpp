@@ -30,6 +30,7 @@
 #include "function_internal.hpp"
 #include "factory.hpp"
 #include "serializing_stream.hpp"
+#include "profiler.hpp"
 
 // To reuse variables we need to be able to sort by sparsity pattern
 #include <unordered_map>
@@ -45,6 +46,13 @@ throw CasadiException("Error in XFunction::" FNAME " for '" + this->name_ + "' "
 
 namespace casadi {
 
+  /** \brief Memory for SXFunction and MXFunction */
+  struct CASADI_EXPORT XFunctionMemory : public FunctionMemory {
+    // Executions and profiler ticks per instruction category, last call
+    std::vector<casadi_int> instr_n_call;
+    std::vector<uint64_t> instr_ticks;
+  };
+
   /** \brief  Internal node class for the base class of SXFunction and MXFunction
       (lacks a public counterpart)
       The design of the class uses the curiously recurring template pattern (CRTP) idiom
@@ -129,6 +137,14 @@ namespace casadi {
                      const Dict& opts) const override;
     ///@}
 
+    /** \brief Return selected Jacobian blocks, without calculating the others */
+    Function get_jac_block(const std::string& name,
+                           const std::vector<casadi_int>& oind,
+                           const std::vector<casadi_int>& iind,
+                           const std::vector<std::string>& inames,
+                           const std::vector<std::string>& onames,
+                           const Dict& opts) const override;
+
     ///@{
     /** \brief Return Jacobian of all input elements with respect to all output elements */
     bool has_jacobian() const override { return true;}
@@ -212,8 +228,41 @@ namespace casadi {
     void delayed_deserialize_members(DeserializingStream &s);
     //@}
 
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new XFunctionMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override { delete static_cast<XFunctionMemory*>(mem);}
+
+    /** \brief Get all statistics */
+    Dict get_stats(void* mem) const override;
+
+    /** \brief Group instructions into categories for instruction profiling
+     *
+     * Instructions with the same name share a category. Nested categories
+     * (embedded function calls) are not forwarded to the Profiler, which
+     * records the callee itself.
+    */
+    void init_instr_profile(const std::vector<std::string>& instr_name,
+                            const std::vector<bool>& instr_nested);
+
+    /** \brief Forward the instruction profile of a call to the Profiler */
+    void instr_profile_done(XFunctionMemory* m) const;
+
     // Data members (all public)
 
+    /** \brief Instruction category, for profile_instructions */
+    std::vector<casadi_int> instr_cat_;
+
+    /** \brief Names of the instruction categories */
+    std::vector<std::string> instr_cat_name_;
+
+    /** \brief Is the instruction category a nested function evaluation */
+    std::vector<bool> instr_cat_nested_;
+
     /** \brief  Inputs of the function (needed for symbolic calculations) */
     std::vector<MatType> in_;
 
@@ -274,6 +323,59 @@ namespace casadi {
     // 'out' member needs to be delayed
   }
 
+  template<typename DerivedType, typename MatType, typename NodeType>
+  int XFunction<DerivedType, MatType, NodeType>::init_mem(void* mem) const {
+    if (FunctionInternal::init_mem(mem)) return 1;
+    auto m = static_cast<XFunctionMemory*>(mem);
+    m->instr_n_call.resize(instr_cat_name_.size(), 0);
+    m->instr_ticks.resize(instr_cat_name_.size(), 0);
+    return 0;
+  }
+
+  template<typename DerivedType, typename MatType, typename NodeType>
+  Dict XFunction<DerivedType, MatType, NodeType>::get_stats(void* mem) const {
+    Dict stats = FunctionInternal::get_stats(mem);
+    auto m = static_cast<XFunctionMemory*>(mem);
+    if (!instr_cat_name_.empty()) {
+      double tick_period = Profiler::tick_period();
+      Dict instr;
+      for (casadi_int c=0; c<instr_cat_name_.size(); ++c) {
+        instr[instr_cat_name_[c]] = Dict{{"n_call", m->instr_n_call[c]},
+          {"t_wall", static_cast<double>(m->instr_ticks[c])*tick_period}};
+      }
+      stats["instructions"] = instr;
+    }
+    return stats;
+  }
+
+  template<typename DerivedType, typename MatType, typename NodeType>
+  void XFunction<DerivedType, MatType, NodeType>::
+  init_instr_profile(const std::vector<std::string>& instr_name,
+                     const std::vector<bool>& instr_nested) {
+    instr_cat_.resize(instr_name.size());
+    instr_cat_name_.clear();
+    instr_cat_nested_.clear();
+    std::map<std::string, casadi_int> cat;
+    for (casadi_int k=0; k<instr_name.size(); ++k) {
+      auto it = cat.insert(std::make_pair(instr_name[k], instr_cat_name_.size())).first;
+      if (it->second==instr_cat_name_.size()) {
+        instr_cat_name_.push_back(instr_name[k]);
+        instr_cat_nested_.push_back(instr_nested[k]);
+      }
+      instr_cat_[k] = it->second;
+    }
+  }
+
+  template<typename DerivedType, typename MatType, typename NodeType>
+  void XFunction<DerivedType, MatType, NodeType>::
+  instr_profile_done(XFunctionMemory* m) const {
+    if (!Profiler::is_active()) return;
+    for (casadi_int c=0; c<instr_cat_name_.size(); ++c) {
+      if (instr_cat_nested_[c]) continue;
+      Profiler::add(instr_cat_name_[c], m->instr_n_call[c], m->instr_ticks[c]);
+    }
+  }
+
   template<typename DerivedType, typename MatType, typename NodeType>
   void XFunction<DerivedType, MatType, NodeType>::init(const Dict& opts) {
     // Call the init function of the base class
@@ -861,6 +963,42 @@ namespace casadi {
     }
   }
 
+  template<typename DerivedType, typename MatType, typename NodeType>
+  Function XFunction<DerivedType, MatType, NodeType>
+  ::get_jac_block(const std::string& name,
+                  const std::vector<casadi_int>& oind,
+                  const std::vector<casadi_int>& iind,
+                  const std::vector<std::string>& inames,
+                  const std::vector<std::string>& onames,
+                  const Dict& opts) const {
+    try {
+      // Each block separately, coloring only its own sparsity pattern
+      std::vector<MatType> ret_out;
+      ret_out.reserve(onames.size());
+      for (casadi_int o : oind) {
+        for (casadi_int i : iind) {
+          if (!is_diff_out_[o] || !is_diff_in_[i]) {
+            ret_out.push_back(MatType(numel_out(o), numel_in(i)));
+          } else {
+            ret_out.push_back(jac(i, o, Dict()));
+          }
+        }
+      }
+
+      // All inputs of the return function
+      std::vector<MatType> ret_in(inames.size());
+      copy(in_.begin(), in_.end(), ret_in.begin());
+      for (casadi_int i=0; i<n_out_; ++i) {
+        ret_in.at(n_in_+i) = MatType::sym(inames[n_in_+i], Sparsity(out_.at(i).size()));
+      }
+
+      // Assemble function and return
+      return Function(name, ret_in, ret_out, inames, onames, opts);
+    } catch (std::exception& e) {
+      CASADI_THROW_ERROR("get_jac_block", e.what());
+    }
+  }
+
   template<typename DerivedType, typename MatType, typename NodeType>
   Function XFunction<DerivedType, MatType, NodeType>
   ::get_jacobian(const std::string& name,
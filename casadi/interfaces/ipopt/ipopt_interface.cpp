@@ -251,6 +251,17 @@ namespace casadi {
       alloc_iw(convexify_data_.sz_iw);
       alloc_w(convexify_data_.sz_w);
     }
+
+    // Handles for the callbacks
+    set_function_handles();
+  }
+
+  void IpoptInterface::set_function_handles() {
+    ind_f_ = function_index("nlp_f");
+    ind_g_ = function_index("nlp_g");
+    ind_grad_f_ = function_index("nlp_grad_f");
+    ind_jac_g_ = function_index("nlp_jac_g");
+    ind_hess_l_ = has_function("nlp_hess_l") ? function_index("nlp_hess_l") : -1;
   }
 
   int IpoptInterface::init_mem(void* mem) const {
@@ -752,6 +763,7 @@ namespace casadi {
       inactive_lam_strategy_ = "reltol";
       inactive_lam_value_ = 10;
     }
+    set_function_handles();
   }
 
   void IpoptInterface::serialize_body(SerializingStream &s) const {
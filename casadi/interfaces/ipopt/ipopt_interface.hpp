@@ -153,6 +153,12 @@ namespace casadi {
     /// Exact Hessian?
     bool exact_hessian_;
 
+    /// Handles of the oracle functions
+    casadi_int ind_f_, ind_g_, ind_grad_f_, ind_jac_g_, ind_hess_l_;
+
+    /// Look up the handles of the oracle functions
+    void set_function_handles();
+
     /// All IPOPT options
     Dict opts_;
 
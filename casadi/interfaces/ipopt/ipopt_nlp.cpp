@@ -89,7 +89,7 @@ namespace casadi {
     mem_->arg[0] = x;
     mem_->arg[1] = mem_->d_nlp.p;
     mem_->res[0] = &obj_value;
-    return solver_.calc_function(mem_, "nlp_f")==0;
+    return solver_.calc_function(mem_, solver_.ind_f_)==0;
   }
 
   // return the gradient of the objective function grad_ {x} f(x)
@@ -98,7 +98,7 @@ namespace casadi {
     mem_->arg[1] = mem_->d_nlp.p;
     mem_->res[0] = nullptr;
     mem_->res[1] = grad_f;
-    return solver_.calc_function(mem_, "nlp_grad_f")==0;
+    return solver_.calc_function(mem_, solver_.ind_grad_f_)==0;
   }
 
   // return the value of the constraints: g(x)
@@ -106,7 +106,7 @@ namespace casadi {
     mem_->arg[0] = x;
     mem_->arg[1] = mem_->d_nlp.p;
     mem_->res[0] = g;
-    return solver_.calc_function(mem_, "nlp_g")==0;
+    return solver_.calc_function(mem_, solver_.ind_g_)==0;
   }
 
   // return the structure or values of the jacobian
@@ -119,7 +119,7 @@ namespace casadi {
       mem_->arg[1] = mem_->d_nlp.p;
       mem_->res[0] = nullptr;
       mem_->res[1] = values;
-      return solver_.calc_function(mem_, "nlp_jac_g")==0;
+      return solver_.calc_function(mem_, solver_.ind_jac_g_)==0;
     } else {
       // Get the sparsity pattern
       casadi_int ncol = solver_.jacg_sp_.size2();
@@ -150,7 +150,7 @@ namespace casadi {
       mem_->arg[2] = &obj_factor;
       mem_->arg[3] = lambda;
       mem_->res[0] = values;
-      if (solver_.calc_function(mem_, "nlp_hess_l")) return false;
+      if (solver_.calc_function(mem_, solver_.ind_hess_l_)) return false;
       if (solver_.convexify_) {
         ScopedTiming tic(mem_->fstats.at("convexify"));
         if (convexify_eval(&solver_.convexify_data_.config, values, values, mem_->iw, mem_->w)) {
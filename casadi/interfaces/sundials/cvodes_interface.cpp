@@ -130,6 +130,20 @@ namespace casadi {
                         {"t", "x", "p", "rx", "rp", "fwd:rx"}, {"fwd:rode"});
       }
     }
+
+    // Handles for the callbacks
+    set_function_handles();
+  }
+
+  void CvodesInterface::set_function_handles() {
+    ind_odeF_ = has_function("odeF") ? function_index("odeF") : -1;
+    ind_quadF_ = has_function("quadF") ? function_index("quadF") : -1;
+    ind_odeB_ = has_function("odeB") ? function_index("odeB") : -1;
+    ind_quadB_ = has_function("quadB") ? function_index("quadB") : -1;
+    ind_jtimesF_ = has_function("jtimesF") ? function_index("jtimesF") : -1;
+    ind_jtimesB_ = has_function("jtimesB") ? function_index("jtimesB") : -1;
+    ind_jacF_ = has_function("jacF") ? function_index("jacF") : -1;
+    ind_jacB_ = has_function("jacB") ? function_index("jacB") : -1;
   }
 
   int CvodesInterface::init_mem(void* mem) const {
@@ -226,7 +240,7 @@ namespace casadi {
       m->arg[1] = m->p;
       m->arg[2] = &t;
       m->res[0] = NV_DATA_S(xdot);
-      s.calc_function(m, "odeF");
+      s.calc_function(m, s.ind_odeF_);
       return 0;
     } catch(int flag) { // recoverable error
       return flag;
@@ -414,7 +428,7 @@ namespace casadi {
       m->arg[1] = m->p;
       m->arg[2] = &t;
       m->res[0] = NV_DATA_S(qdot);
-      s.calc_function(m, "quadF");
+      s.calc_function(m, s.ind_quadF_);
       return 0;
     } catch(int flag) { // recoverable error
       return flag;
@@ -436,7 +450,7 @@ namespace casadi {
       m->arg[3] = m->p;
       m->arg[4] = &t;
       m->res[0] = NV_DATA_S(rxdot);
-      s.calc_function(m, "odeB");
+      s.calc_function(m, s.ind_odeB_);
 
       // Negate (note definition of g)
       casadi_scal(s.nrx_, -1., NV_DATA_S(rxdot));
@@ -462,7 +476,7 @@ namespace casadi {
       m->arg[3] = m->p;
       m->arg[4] = &t;
       m->res[0] = NV_DATA_S(rqdot);
-      s.calc_function(m, "quadB");
+      s.calc_function(m, s.ind_quadB_);
 
       // Negate (note definition of g)
       casadi_scal(s.nrq_, -1., NV_DATA_S(rqdot));
@@ -486,7 +500,7 @@ namespace casadi {
       m->arg[2] = m->p;
       m->arg[3] = NV_DATA_S(v);
       m->res[0] = NV_DATA_S(Jv);
-      s.calc_function(m, "jtimesF");
+      s.calc_function(m, s.ind_jtimesF_);
       return 0;
     } catch(casadi_int flag) { // recoverable error
       return flag;
@@ -509,7 +523,7 @@ namespace casadi {
       m->arg[4] = m->rp;
       m->arg[5] = NV_DATA_S(v);
       m->res[0] = NV_DATA_S(Jv);
-      s.calc_function(m, "jtimesB");
+      s.calc_function(m, s.ind_jtimesB_);
       return 0;
     } catch(int flag) { // recoverable error
       return flag;
@@ -553,7 +567,7 @@ namespace casadi {
           m->arg[2] = m->p; // p
           m->arg[3] = v; // fwd:x
           m->res[0] = m->v2; // fwd:ode
-          s.calc_function(m, "jtimesF");
+          s.calc_function(m, s.ind_jtimesF_);
 
           // Subtract m->v2 from m->v1, scaled with -gamma
           casadi_axpy(s.nx_ - s.nx1_, m->gamma, m->v2 + s.nx1_, m->v1 + s.nx1_);
@@ -606,7 +620,7 @@ namespace casadi {
           m->arg[4] = m->rp; // rp
           m->arg[5] = v; // fwd:rx
           m->res[0] = m->v2; // fwd:rode
-          s.calc_function(m, "jtimesB");
+          s.calc_function(m, s.ind_jtimesB_);
 
           // Subtract m->v2 from m->v1, scaled with gammaB
           casadi_axpy(s.nrx_-s.nrx1_, -m->gammaB, m->v2 + s.nrx1_, m->v1 + s.nrx1_);
@@ -647,7 +661,7 @@ namespace casadi {
       m->arg[3] = &d1;
       m->arg[4] = &d2;
       m->res[0] = m->jac;
-      if (s.calc_function(m, "jacF")) casadi_error("'jacF' calculation failed");
+      if (s.calc_function(m, s.ind_jacF_)) casadi_error("'jacF' calculation failed");
 
       // Prepare the solution of the linear system (e.g. factorize)
       if (s.linsolF_.nfact(m->jac, m->mem_linsolF)) casadi_error("'jacF' factorization failed");
@@ -680,7 +694,7 @@ namespace casadi {
       m->arg[5] = &gammaB;
       m->arg[6] = &one;
       m->res[0] = m->jacB;
-      if (s.calc_function(m, "jacB")) casadi_error("'jacB' calculation failed");
+      if (s.calc_function(m, s.ind_jacB_)) casadi_error("'jacB' calculation failed");
 
       // Prepare the solution of the linear system (e.g. factorize)
       if (s.linsolB_.nfact(m->jacB, m->mem_linsolB)) casadi_error("'jacB' factorization failed");
@@ -876,6 +890,7 @@ namespace casadi {
     } else {
       min_step_size_ = 0;
     }
+    set_function_handles();
   }
 
   void CvodesInterface::serialize_body(SerializingStream &s) const {
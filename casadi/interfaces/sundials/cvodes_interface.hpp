@@ -196,6 +196,13 @@ namespace casadi {
     casadi_int lmm_; // linear multistep method
     casadi_int iter_; // nonlinear solver iteration
 
+    // Handles of the oracle functions
+    casadi_int ind_odeF_, ind_quadF_, ind_odeB_, ind_quadB_;
+    casadi_int ind_jtimesF_, ind_jtimesB_, ind_jacF_, ind_jacB_;
+
+    // Look up the handles of the oracle functions
+    void set_function_handles();
+
 
   public:
 
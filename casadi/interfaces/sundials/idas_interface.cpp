@@ -168,6 +168,20 @@ namespace casadi {
           {"fwd:rode", "fwd:ralg"});
       }
     }
+
+    // Handles for the callbacks
+    set_function_handles();
+  }
+
+  void IdasInterface::set_function_handles() {
+    ind_daeF_ = has_function("daeF") ? function_index("daeF") : -1;
+    ind_quadF_ = has_function("quadF") ? function_index("quadF") : -1;
+    ind_daeB_ = has_function("daeB") ? function_index("daeB") : -1;
+    ind_quadB_ = has_function("quadB") ? function_index("quadB") : -1;
+    ind_jtimesF_ = has_function("jtimesF") ? function_index("jtimesF") : -1;
+    ind_jtimesB_ = has_function("jtimesB") ? function_index("jtimesB") : -1;
+    ind_jacF_ = has_function("jacF") ? function_index("jacF") : -1;
+    ind_jacB_ = has_function("jacB") ? function_index("jacB") : -1;
   }
 
   int IdasInterface::res(double t, N_Vector xz, N_Vector xzdot,
@@ -181,7 +195,7 @@ namespace casadi {
       m->arg[3] = &t;
       m->res[0] = NV_DATA_S(rr);
       m->res[1] = NV_DATA_S(rr)+s.nx_;
-      s.calc_function(m, "daeF");
+      s.calc_function(m, s.ind_daeF_);
 
       // Subtract state derivative to get residual
       casadi_axpy(s.nx_, -1., NV_DATA_S(xzdot), NV_DATA_S(rr));
@@ -219,7 +233,7 @@ namespace casadi {
       m->arg[5] = NV_DATA_S(v)+s.nx_;
       m->res[0] = NV_DATA_S(Jv);
       m->res[1] = NV_DATA_S(Jv)+s.nx_;
-      s.calc_function(m, "jtimesF");
+      s.calc_function(m, s.ind_jtimesF_);
 
       // Subtract state derivative to get residual
       casadi_axpy(s.nx_, -cj, NV_DATA_S(v), NV_DATA_S(Jv));
@@ -251,7 +265,7 @@ namespace casadi {
       m->arg[8] = NV_DATA_S(vB)+s.nrx_;
       m->res[0] = NV_DATA_S(JvB);
       m->res[1] = NV_DATA_S(JvB) + s.nrx_;
-      s.calc_function(m, "jtimesB");
+      s.calc_function(m, s.ind_jtimesB_);
 
       // Subtract state derivative to get residual
       casadi_axpy(s.nrx_, cjB, NV_DATA_S(vB), NV_DATA_S(JvB));
@@ -601,7 +615,7 @@ namespace casadi {
       m->arg[2] = m->p;
       m->arg[3] = &t;
       m->res[0] = NV_DATA_S(rhsQ);
-      s.calc_function(m, "quadF");
+      s.calc_function(m, s.ind_quadF_);
 
       return 0;
     } catch(int flag) { // recoverable error
@@ -626,7 +640,7 @@ namespace casadi {
       m->arg[6] = &t;
       m->res[0] = NV_DATA_S(rr);
       m->res[1] = NV_DATA_S(rr)+s.nrx_;
-      s.calc_function(m, "daeB");
+      s.calc_function(m, s.ind_daeB_);
 
       // Subtract state derivative to get residual
       casadi_axpy(s.nrx_, 1., NV_DATA_S(rxzdot), NV_DATA_S(rr));
@@ -653,7 +667,7 @@ namespace casadi {
       m->arg[5] = m->p;
       m->arg[6] = &t;
       m->res[0] = NV_DATA_S(rqdot);
-      s.calc_function(m, "quadB");
+      s.calc_function(m, s.ind_quadB_);
 
       // Negate (note definition of g)
       casadi_scal(s.nrq_, -1., NV_DATA_S(rqdot));
@@ -715,7 +729,7 @@ namespace casadi {
           m->arg[5] = vz; // fwd:z
           m->res[0] = m->v2; // fwd:ode
           m->res[1] = m->v2 + s.nx_; // fwd:alg
-          s.calc_function(m, "jtimesF");
+          s.calc_function(m, s.ind_jtimesF_);
 
           // Subtract m->v2 (reordered) from m->v1
           v_it = m->v1 + s.nx1_ + s.nz1_;
@@ -798,7 +812,7 @@ namespace casadi {
           m->arg[8] = vz; // fwd:rz
           m->res[0] = m->v2; // fwd:rode
           m->res[1] = m->v2 + s.nrx_; // fwd:ralg
-          s.calc_function(m, "jtimesB");
+          s.calc_function(m, s.ind_jtimesB_);
 
           // Subtract m->v2 (reordered) from m->v1
           v_it = m->v1 + s.nrx1_ + s.nrz1_;
@@ -846,7 +860,7 @@ namespace casadi {
       m->arg[3] = m->p;
       m->arg[4] = &cj;
       m->res[0] = m->jac;
-      if (s.calc_function(m, "jacF")) casadi_error("Calculating Jacobian failed");
+      if (s.calc_function(m, s.ind_jacF_)) casadi_error("Calculating Jacobian failed");
 
       // Factorize the linear system
       if (s.linsolF_.nfact(m->jac, m->mem_linsolF)) casadi_error("Linear solve failed");
@@ -876,7 +890,7 @@ namespace casadi {
       m->arg[6] = m->p;
       m->arg[7] = &cj;
       m->res[0] = m->jacB;
-      if (s.calc_function(m, "jacB")) casadi_error("'jacB' calculation failed");
+      if (s.calc_function(m, s.ind_jacB_)) casadi_error("'jacB' calculation failed");
 
       // Factorize the linear system
       if (s.linsolB_.nfact(m->jacB, m->mem_linsolB)) casadi_error("'jacB' factorization failed");
@@ -1085,6 +1099,7 @@ namespace casadi {
       s.unpack("IdasInterface::max_step_size", max_step_size_);
       s.unpack("IdasInterface::y_c", y_c_);
     }
+    set_function_handles();
   }
 
   void IdasInterface::serialize_body(SerializingStream &s) const {
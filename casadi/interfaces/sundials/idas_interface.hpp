@@ -209,6 +209,13 @@ namespace casadi {
     //  Initial values for \p xdot
     std::vector<double> init_xdot_;
 
+    // Handles of the oracle functions
+    casadi_int ind_daeF_, ind_quadF_, ind_daeB_, ind_quadB_;
+    casadi_int ind_jtimesF_, ind_jtimesB_, ind_jacF_, ind_jacB_;
+
+    // Look up the handles of the oracle functions
+    void set_function_handles();
+
     /** \brief Serialize an object without type information */
     void serialize_body(SerializingStream &s) const override;
 
@@ -0,0 +1,514 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "condensing.hpp"
+#include <numeric>
+
+using namespace std;
+namespace casadi {
+
+  extern "C"
+  int CASADI_CONIC_CONDENSING_EXPORT
+  casadi_register_conic_condensing(Conic::Plugin* plugin) {
+    plugin->creator = Condensing::creator;
+    plugin->name = "condensing";
+    plugin->doc = Condensing::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &Condensing::options_;
+    plugin->deserialize = &Condensing::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_CONIC_CONDENSING_EXPORT casadi_load_conic_condensing() {
+    Conic::registerPlugin(casadi_register_conic_condensing);
+  }
+
+  Condensing::Condensing(const std::string& name, const std::map<std::string, Sparsity> &st)
+    : Conic(name, st) {
+  }
+
+  Condensing::~Condensing() {
+    clear_mem();
+  }
+
+  void* Condensing::alloc_mem() const {
+    CondensingMemory *m = new CondensingMemory();
+    m->qp_mem = qpsol_.checkout();
+    return m;
+  }
+
+  void Condensing::free_mem(void *mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    qpsol_.release(m->qp_mem);
+    delete m;
+  }
+
+  const Options Condensing::options_
+  = {{&Conic::options_},
+     {{"qpsol",
+       {OT_STRING,
+        "Solver for the condensed QP [qrqp]."}},
+      {"qpsol_options",
+       {OT_DICT,
+        "Options to be passed to the solver for the condensed QP."}},
+      {"N",
+       {OT_INT,
+        "OCP horizon"}},
+      {"nx",
+       {OT_INTVECTOR,
+        "Number of states, length N+1"}},
+      {"nu",
+       {OT_INTVECTOR,
+        "Number of controls, length N"}},
+      {"ng",
+       {OT_INTVECTOR,
+        "Number of non-dynamic constraints, length N+1"}}
+     }
+  };
+
+  void Condensing::init(const Dict& opts) {
+    // Initialize the base classes
+    Conic::init(opts);
+
+    // Default options
+    string qpsol_plugin = "qrqp";
+    Dict qpsol_options;
+    casadi_int N = 0;
+    std::vector<casadi_int> nx, nu, ng;
+    casadi_int struct_cnt=0;
+
+    // Read user options
+    for (auto&& op : opts) {
+      if (op.first=="qpsol") {
+        qpsol_plugin = op.second.to_string();
+      } else if (op.first=="qpsol_options") {
+        qpsol_options = op.second;
+      } else if (op.first=="N") {
+        N = op.second;
+        struct_cnt++;
+      } else if (op.first=="nx") {
+        nx = op.second;
+        struct_cnt++;
+      } else if (op.first=="nu") {
+        nu = op.second;
+        struct_cnt++;
+      } else if (op.first=="ng") {
+        ng = op.second;
+        struct_cnt++;
+      }
+    }
+
+    casadi_assert(struct_cnt==0 || struct_cnt==4,
+      "You must either set all of N, nx, nu, ng; "
+      "or set none at all (automatic detection).");
+
+    if (struct_cnt==0) {
+      detect_structure(A_, nx, nu, ng);
+      N = nu.size();
+      if (verbose_) {
+        casadi_message("Detected structure: N " + str(N) + ", nx " + str(nx) + ", "
+          "nu " + str(nu) + ", ng " + str(ng) + ".");
+      }
+    }
+
+    casadi_assert(nx.size()==N+1 && nu.size()==N && ng.size()==N+1,
+      "Expected nx and ng of length N+1 and nu of length N. "
+      "Structure is: N " + str(N) + ", nx " + str(nx) + ", "
+      "nu " + str(nu) + ", ng " + str(ng) + ".");
+    casadi_assert(nx_ == std::accumulate(nx.begin(), nx.end(), 0) + // NOLINT
+      std::accumulate(nu.begin(), nu.end(), 0),
+      "sum(nx)+sum(nu) = must equal total size of variables (" + str(nx_) + "). "
+      "Structure is: N " + str(N) + ", nx " + str(nx) + ", "
+      "nu " + str(nu) + ", ng " + str(ng) + ".");
+    casadi_assert(na_ == std::accumulate(nx.begin()+1, nx.end(), 0) + // NOLINT
+      std::accumulate(ng.begin(), ng.end(), 0),
+      "sum(nx+1)+sum(ng) = must equal total size of constraints (" + str(na_) + "). "
+      "Structure is: N " + str(N) + ", nx " + str(nx) + ", "
+      "nu " + str(nu) + ", ng " + str(ng) + ".");
+
+    // Partition the variables: x0 and all controls are kept, x1..xN are eliminated
+    w_.clear();
+    s_.clear();
+    casadi_int offset = 0;
+    for (casadi_int k=0; k<=N; ++k) {
+      for (casadi_int i=0; i<nx[k]; ++i) (k==0 ? w_ : s_).push_back(offset++);
+      if (k<N) {
+        for (casadi_int i=0; i<nu[k]; ++i) w_.push_back(offset++);
+      }
+    }
+
+    // Partition the constraints: gap k defines x(k+1), all others are kept
+    e_.clear();
+    r_.clear();
+    offset = 0;
+    for (casadi_int k=0; k<=N; ++k) {
+      if (k<N) {
+        for (casadi_int i=0; i<nx[k+1]; ++i) e_.push_back(offset++);
+      }
+      for (casadi_int i=0; i<ng[k]; ++i) r_.push_back(offset++);
+    }
+    nw_ = w_.size();
+    ns_ = s_.size();
+    nr_ = r_.size();
+
+    // Position of each variable in w or s
+    pos_.resize(nx_);
+    for (casadi_int i=0; i<nw_; ++i) pos_[w_[i]] = i;
+    for (casadi_int i=0; i<ns_; ++i) pos_[s_[i]] = i;
+    vector<bool> is_s(nx_, false);
+    for (casadi_int i : s_) is_s[i] = true;
+
+    // Gap k may only depend on x(k+1) through its pivot and on eliminated states
+    // that precede it, so that the states can be eliminated by forward substitution
+    AT_ = A_.transpose(at_nz_);
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+    piv_.resize(ns_);
+    for (casadi_int j=0; j<ns_; ++j) {
+      piv_[j] = -1;
+      for (casadi_int k=at_colind[e_[j]]; k<at_colind[e_[j]+1]; ++k) {
+        casadi_int c = at_row[k];
+        if (c==s_[j]) {
+          piv_[j] = at_nz_[k];
+        } else {
+          casadi_assert(!is_s[c] || pos_[c]<j,
+            "Constraint " + str(e_[j]) + " is not a gap-closing constraint for variable "
+            + str(s_[j]) + ": it depends on variable " + str(c) + ". "
+            "Structure is: N " + str(N) + ", nx " + str(nx) + ", "
+            "nu " + str(nu) + ", ng " + str(ng) + ".");
+        }
+      }
+      casadi_assert(piv_[j]>=0,
+        "Constraint " + str(e_[j]) + " is not a gap-closing constraint for variable "
+        + str(s_[j]) + ": structural zero on the diagonal. "
+        "Structure is: N " + str(N) + ", nx " + str(nx) + ", "
+        "nu " + str(nu) + ", ng " + str(ng) + ".");
+    }
+
+    // The condensed QP is dense in the free variables
+    Dict qp_opts = qpsol_options;
+    if (qp_opts.find("error_on_fail")==qp_opts.end()) qp_opts["error_on_fail"] = false;
+    qpsol_ = conic("qpsol", qpsol_plugin, {{"h", Sparsity::dense(nw_, nw_)},
+                                          {"a", Sparsity::dense(nr_+ns_, nw_)}}, qp_opts);
+    alloc(qpsol_);
+
+    // Condensing matrix and offset, x = M*w + m
+    alloc_w(nx_*nw_ + nx_, true);
+    // H*M, A*M, A*m
+    alloc_w(nx_*nw_ + na_*nw_ + na_, true);
+    // Condensed QP data
+    alloc_w(nw_*nw_ + nw_ + (nr_+ns_)*nw_, true);
+    // Bounds and initial guess for the condensed QP
+    alloc_w(4*nw_ + 3*(nr_+ns_), true);
+    // Solution of the condensed QP
+    alloc_w(2*nw_ + nr_+ns_, true);
+    // Expanded primal-dual solution
+    alloc_w(3*nx_ + na_, true);
+  }
+
+  void Condensing::detect_structure(const Sparsity& A, std::vector<casadi_int>& nx,
+      std::vector<casadi_int>& nu, std::vector<casadi_int>& ng) {
+    nx.clear();
+    nu.clear();
+    ng.clear();
+    casadi_int na = A.size1();
+
+    // Find the right-most column for each row in A -> A_skyline
+    // Find the second-to-right-most column -> A_skyline2
+    // Find the left-most column -> A_bottomline
+    Sparsity AT = A.T();
+    std::vector<casadi_int> A_skyline;
+    std::vector<casadi_int> A_skyline2;
+    std::vector<casadi_int> A_bottomline;
+    for (casadi_int i=0;i<AT.size2();++i) {
+      casadi_int pivot = AT.colind()[i+1];
+      if (pivot>AT.colind()[i]) {
+        A_bottomline.push_back(AT.row()[AT.colind()[i]]);
+        A_skyline.push_back(AT.row()[pivot-1]);
+        if (pivot>AT.colind()[i]+1) {
+          A_skyline2.push_back(AT.row()[pivot-2]);
+        } else {
+          A_skyline2.push_back(-1);
+        }
+      } else {
+        A_bottomline.push_back(-1);
+        A_skyline.push_back(-1);
+        A_skyline2.push_back(-1);
+      }
+    }
+
+    /*
+    Loop over the right-most columns of A:
+    they form the diagonal part due to xk+1 in gap constraints.
+    detect when the diagonal pattern is broken -> new stage
+    */
+    casadi_int pivot = 0; // Current right-most element
+    casadi_int start_pivot = pivot; // First right-most element that started the stage
+    casadi_int cg = 0; // Counter for non-gap-closing constraints
+    for (casadi_int i=0;i<na;++i) { // Loop over all rows
+      bool commit = false; // Set true to jump to the stage
+      if (A_skyline[i]>pivot+1) { // Jump to a diagonal in the future
+        nu.push_back(A_skyline[i]-pivot-1); // Size of jump equals number of states
+        commit = true;
+      } else if (A_skyline[i]==pivot+1) { // Walking the diagonal
+        if (A_skyline2[i]<start_pivot) { // Free of below-diagonal entries?
+          pivot++;
+        } else {
+          nu.push_back(0); // We cannot but conclude that we arrived at a new stage
+          commit = true;
+        }
+      } else { // non-gap-closing constraint detected
+        cg++;
+      }
+
+      if (commit) {
+        nx.push_back(pivot-start_pivot+1);
+        ng.push_back(cg); cg=0;
+        start_pivot = A_skyline[i];
+        pivot = A_skyline[i];
+      }
+    }
+    casadi_assert(!nu.empty(),
+      "Could not detect any gap-closing constraints in A. "
+      "Set the N, nx, nu and ng options to specify the structure.");
+    nx.push_back(pivot-start_pivot+1);
+
+    // Correction for k==0
+    nx[0] = A_skyline[0];
+    nu[0] = 0;
+    ng.erase(ng.begin());
+    casadi_int cN=0;
+    for (casadi_int i=na-1;i>=0;--i) {
+      if (A_bottomline[i]<start_pivot) break;
+      cN++;
+    }
+    ng.push_back(cg-cN);
+    ng.push_back(cN);
+  }
+
+  int Condensing::
+  solve(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    casadi_int i, j, k, nc = nr_+ns_;
+    const casadi_int *colind = A_.colind(), *row = A_.row();
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+
+    // Inputs
+    const double *h = arg[CONIC_H], *g = arg[CONIC_G], *a = arg[CONIC_A],
+                 *lba = arg[CONIC_LBA], *uba = arg[CONIC_UBA],
+                 *lbx = arg[CONIC_LBX], *ubx = arg[CONIC_UBX],
+                 *x0 = arg[CONIC_X0], *lam_x0 = arg[CONIC_LAM_X0],
+                 *lam_a0 = arg[CONIC_LAM_A0];
+
+    // Work vectors
+    double *M = w; w += nx_*nw_;
+    double *mv = w; w += nx_;
+    double *HM = w; w += nx_*nw_;
+    double *AM = w; w += na_*nw_;
+    double *Am = w; w += na_;
+    double *hc = w; w += nw_*nw_;
+    double *gc = w; w += nw_;
+    double *ac = w; w += nc*nw_;
+    double *lbw = w; w += nw_;
+    double *ubw = w; w += nw_;
+    double *lbc = w; w += nc;
+    double *ubc = w; w += nc;
+    double *x0w = w; w += nw_;
+    double *lam_w0 = w; w += nw_;
+    double *lam_c0 = w; w += nc;
+    double *xw = w; w += nw_;
+    double *lam_w = w; w += nw_;
+    double *lam_c = w; w += nc;
+    double *z = w; w += nx_;
+    double *lam_x = w; w += nx_;
+    double *r = w; w += nx_;
+    double *lam_a = w; w += na_;
+
+    // Eliminate the states by forward substitution over the gap-closing constraints
+    casadi_fill(M, nx_*nw_, 0.);
+    casadi_fill(mv, nx_, 0.);
+    for (j=0; j<nw_; ++j) M[w_[j] + j*nx_] = 1;
+    for (j=0; j<ns_; ++j) {
+      casadi_int e = e_[j], c = s_[j];
+      double l = lba ? lba[e] : 0, u = uba ? uba[e] : 0;
+      casadi_assert(l==u, "Gap-closing constraint " + str(e) + " must be an equality "
+        "constraint, got bounds [" + str(l) + ", " + str(u) + "].");
+      double piv = a ? a[piv_[j]] : 0;
+      casadi_assert(piv!=0, "Gap-closing constraint " + str(e) + " does not depend on "
+        "variable " + str(c) + ".");
+      // a_ec*x_c = l - sum_{i!=c} a_ei*x_i, with x_i = M(i,:)*w + m_i
+      mv[c] = l;
+      for (k=at_colind[e]; k<at_colind[e+1]; ++k) {
+        i = at_row[k];
+        if (i==c) continue;
+        double a_ei = a[at_nz_[k]];
+        mv[c] -= a_ei*mv[i];
+        for (casadi_int q=0; q<nw_; ++q) M[c + q*nx_] -= a_ei*M[i + q*nx_];
+      }
+      mv[c] /= piv;
+      for (casadi_int q=0; q<nw_; ++q) M[c + q*nx_] /= piv;
+    }
+
+    // Condensed Hessian and gradient: M'*H*M and M'*(H*m + g)
+    casadi_fill(HM, nx_*nw_, 0.);
+    for (j=0; j<nw_; ++j) casadi_mv(h, H_, M + j*nx_, HM + j*nx_, false);
+    for (j=0; j<nw_; ++j) {
+      for (i=0; i<nw_; ++i) hc[i + j*nw_] = casadi_dot(nx_, M + i*nx_, HM + j*nx_);
+    }
+    casadi_copy(g, nx_, r);
+    casadi_mv(h, H_, mv, r, false);
+    for (i=0; i<nw_; ++i) gc[i] = casadi_dot(nx_, M + i*nx_, r);
+
+    // Condensed constraints: remaining rows of A*M, followed by the eliminated states
+    casadi_fill(AM, na_*nw_, 0.);
+    for (j=0; j<nw_; ++j) casadi_mv(a, A_, M + j*nx_, AM + j*na_, false);
+    casadi_fill(Am, na_, 0.);
+    casadi_mv(a, A_, mv, Am, false);
+    for (j=0; j<nw_; ++j) {
+      for (i=0; i<nr_; ++i) ac[i + j*nc] = AM[r_[i] + j*na_];
+      for (i=0; i<ns_; ++i) ac[nr_ + i + j*nc] = M[s_[i] + j*nx_];
+    }
+
+    // Bounds and initial guess
+    for (i=0; i<nw_; ++i) {
+      lbw[i] = lbx ? lbx[w_[i]] : 0;
+      ubw[i] = ubx ? ubx[w_[i]] : 0;
+      x0w[i] = x0 ? x0[w_[i]] : 0;
+      lam_w0[i] = lam_x0 ? lam_x0[w_[i]] : 0;
+    }
+    for (i=0; i<nr_; ++i) {
+      lbc[i] = (lba ? lba[r_[i]] : 0) - Am[r_[i]];
+      ubc[i] = (uba ? uba[r_[i]] : 0) - Am[r_[i]];
+      lam_c0[i] = lam_a0 ? lam_a0[r_[i]] : 0;
+    }
+    for (i=0; i<ns_; ++i) {
+      lbc[nr_+i] = (lbx ? lbx[s_[i]] : 0) - mv[s_[i]];
+      ubc[nr_+i] = (ubx ? ubx[s_[i]] : 0) - mv[s_[i]];
+      lam_c0[nr_+i] = lam_x0 ? lam_x0[s_[i]] : 0;
+    }
+
+    // Solve the condensed QP
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+    fill_n(arg1, static_cast<casadi_int>(CONIC_NUM_IN), nullptr);
+    fill_n(res1, static_cast<casadi_int>(CONIC_NUM_OUT), nullptr);
+    arg1[CONIC_H] = hc;
+    arg1[CONIC_G] = gc;
+    arg1[CONIC_A] = ac;
+    arg1[CONIC_LBA] = lbc;
+    arg1[CONIC_UBA] = ubc;
+    arg1[CONIC_LBX] = lbw;
+    arg1[CONIC_UBX] = ubw;
+    arg1[CONIC_X0] = x0w;
+    arg1[CONIC_LAM_X0] = lam_w0;
+    arg1[CONIC_LAM_A0] = lam_c0;
+    res1[CONIC_X] = xw;
+    res1[CONIC_LAM_X] = lam_w;
+    res1[CONIC_LAM_A] = lam_c;
+    int ret = qpsol_(arg1, res1, iw, w, m->qp_mem);
+    auto qp_m = static_cast<ConicMemory*>(qpsol_.memory(m->qp_mem));
+    m->success = qp_m->success;
+    m->unified_return_status = qp_m->unified_return_status;
+    if (ret) return ret;
+
+    // Expand the primal solution, x = M*w + m
+    casadi_copy(mv, nx_, z);
+    for (j=0; j<nw_; ++j) casadi_axpy(nx_, xw[j], M + j*nx_, z);
+
+    // Multipliers of the simple bounds and the remaining constraints
+    for (i=0; i<nw_; ++i) lam_x[w_[i]] = lam_w[i];
+    for (i=0; i<ns_; ++i) lam_x[s_[i]] = lam_c[nr_+i];
+    casadi_fill(lam_a, na_, 0.);
+    for (i=0; i<nr_; ++i) lam_a[r_[i]] = lam_c[i];
+
+    // Gradient of the Lagrangian without the gap-closing constraints
+    casadi_copy(g, nx_, r);
+    casadi_mv(h, H_, z, r, false);
+    casadi_axpy(nx_, 1., lam_x, r);
+
+    // Multipliers of the gap-closing constraints by backward substitution:
+    // stationarity with respect to x_c involves gap j and later gaps only
+    for (j=ns_-1; j>=0; --j) {
+      casadi_int c = s_[j];
+      double v = r[c];
+      for (k=colind[c]; k<colind[c+1]; ++k) {
+        if (k!=piv_[j]) v += a[k]*lam_a[row[k]];
+      }
+      lam_a[e_[j]] = -v/a[piv_[j]];
+    }
+
+    // Get solution
+    if (res[CONIC_COST]) {
+      res[CONIC_COST][0] = h ? 0.5*casadi_bilin(h, H_, z, z) : 0;
+      if (g) res[CONIC_COST][0] += casadi_dot(nx_, g, z);
+    }
+    casadi_copy(z, nx_, res[CONIC_X]);
+    casadi_copy(lam_x, nx_, res[CONIC_LAM_X]);
+    casadi_copy(lam_a, na_, res[CONIC_LAM_A]);
+    return 0;
+  }
+
+  Dict Condensing::get_stats(void* mem) const {
+    Dict stats = Conic::get_stats(mem);
+    auto m = static_cast<CondensingMemory*>(mem);
+    stats["solver_stats"] = qpsol_->get_stats(qpsol_.memory(m->qp_mem));
+    return stats;
+  }
+
+  Condensing::Condensing(DeserializingStream& s) : Conic(s) {
+    s.version("Condensing", 1);
+    s.unpack("Condensing::qpsol", qpsol_);
+    s.unpack("Condensing::nw", nw_);
+    s.unpack("Condensing::ns", ns_);
+    s.unpack("Condensing::nr", nr_);
+    s.unpack("Condensing::w", w_);
+    s.unpack("Condensing::s", s_);
+    s.unpack("Condensing::e", e_);
+    s.unpack("Condensing::r", r_);
+    s.unpack("Condensing::pos", pos_);
+    s.unpack("Condensing::piv", piv_);
+    s.unpack("Condensing::AT", AT_);
+    s.unpack("Condensing::at_nz", at_nz_);
+  }
+
+  void Condensing::serialize_body(SerializingStream &s) const {
+    Conic::serialize_body(s);
+
+    s.version("Condensing", 1);
+    s.pack("Condensing::qpsol", qpsol_);
+    s.pack("Condensing::nw", nw_);
+    s.pack("Condensing::ns", ns_);
+    s.pack("Condensing::nr", nr_);
+    s.pack("Condensing::w", w_);
+    s.pack("Condensing::s", s_);
+    s.pack("Condensing::e", e_);
+    s.pack("Condensing::r", r_);
+    s.pack("Condensing::pos", pos_);
+    s.pack("Condensing::piv", piv_);
+    s.pack("Condensing::AT", AT_);
+    s.pack("Condensing::at_nz", at_nz_);
+  }
+
+} // namespace casadi
@@ -0,0 +1,157 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_CONDENSING_HPP
+#define CASADI_CONDENSING_HPP
+
+#include "casadi/core/conic_impl.hpp"
+#include <casadi/solvers/casadi_conic_condensing_export.h>
+
+/** \defgroup plugin_Conic_condensing
+
+   Solve OCP-structured QPs by condensing.
+
+   The state variables of stages 1..N are eliminated using the gap-closing
+   (continuity) constraints, leaving a dense QP in the initial state and
+   the controls only. The condensed QP is passed to the solver given by
+   the 'qpsol' option, after which the states and all multipliers are
+   recovered.
+
+   The stage structure is either supplied with the N, nx, nu, ng options or
+   detected automatically from the sparsity of A. The ordering of variables
+   and constraints is the one used by the hpmpc plugin:
+   x = [x0 u0 x1 u1 ... xN] and g = [gap0 lincon0 gap1 lincon1 ... linconN],
+   where gap k reads x(k+1) = f(x(k), u(k)). The gap-closing constraints
+   must be equality constraints.
+*/
+
+/** \pluginsection{Conic,condensing} */
+
+/// \cond INTERNAL
+namespace casadi {
+
+  struct CASADI_CONIC_CONDENSING_EXPORT CondensingMemory : public ConicMemory {
+    // Memory of the condensed QP solver
+    casadi_int qp_mem;
+
+    /// Constructor
+    CondensingMemory() {}
+
+    /// Destructor
+    ~CondensingMemory() {}
+  };
+
+  /** \brief \pluginbrief{Conic,condensing}
+
+      @copydoc Conic_doc
+      @copydoc plugin_Conic_condensing
+  */
+  class CASADI_CONIC_CONDENSING_EXPORT Condensing : public Conic {
+  public:
+    /** \brief  Create a new Solver */
+    explicit Condensing(const std::string& name,
+                        const std::map<std::string, Sparsity> &st);
+
+    /** \brief  Create a new QP Solver */
+    static Conic* creator(const std::string& name,
+                          const std::map<std::string, Sparsity>& st) {
+      return new Condensing(name, st);
+    }
+
+    /** \brief  Destructor */
+    ~Condensing() override;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "condensing";}
+
+    // Get name of the class
+    std::string class_name() const override { return "Condensing";}
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    int solve(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const override;
+
+    /** \brief Detect the stage structure from the sparsity of A */
+    static void detect_structure(const Sparsity& A, std::vector<casadi_int>& nx,
+      std::vector<casadi_int>& nu, std::vector<casadi_int>& ng);
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    /// Solver for the condensed QP
+    Function qpsol_;
+
+    /// Number of free variables, eliminated states and remaining constraints
+    casadi_int nw_, ns_, nr_;
+
+    /// Free variables (initial state and controls)
+    std::vector<casadi_int> w_;
+
+    /// Eliminated states and the gap-closing constraints that define them
+    std::vector<casadi_int> s_, e_;
+
+    /// Constraints passed on to the condensed QP
+    std::vector<casadi_int> r_;
+
+    /// Position of each variable in the free or eliminated variables
+    std::vector<casadi_int> pos_;
+
+    /// Nonzero of A that is the pivot of each gap-closing constraint
+    std::vector<casadi_int> piv_;
+
+    /// Transpose of A, with the corresponding nonzeros of A
+    Sparsity AT_;
+    std::vector<casadi_int> at_nz_;
+
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Condensing(s); }
+
+  protected:
+     /** \brief Deserializing constructor */
+    explicit Condensing(DeserializingStream& s);
+  };
+
+} // namespace casadi
+/// \endcond
+#endif // CASADI_CONDENSING_HPP
@@ -79,9 +79,15 @@ namespace casadi {
 
     lookup_mode_ = Interpolant::interpret_lookup_mode(lookup_modes_, grid_, offset_);
 
-    // Needed by casadi_interpn
-    alloc_w(ndim_, true);
-    alloc_iw(2*ndim_, true);
+    if (batch_x_==1) {
+      // Needed by casadi_interpn
+      alloc_w(ndim_, true);
+      alloc_iw(2*ndim_, true);
+    } else {
+      // Needed by casadi_interpn_batch
+      alloc_w((ndim_+1)*batch_x_, true);
+      alloc_iw((ndim_+1)*batch_x_ + ndim_, true);
+    }
   }
 
   int LinearInterpolant::
@@ -89,8 +95,13 @@ namespace casadi {
     if (res[0]) {
       const double* values = has_parametric_values() ? arg[arg_values()] : get_ptr(values_);
       const double* grid = has_parametric_grid() ? arg[arg_grid()] : get_ptr(grid_);
-      casadi_interpn(res[0], ndim_, grid, get_ptr(offset_),
-                    values, arg[0], get_ptr(lookup_mode_), m_, iw, w);
+      if (batch_x_==1) {
+        casadi_interpn(res[0], ndim_, grid, get_ptr(offset_),
+                      values, arg[0], get_ptr(lookup_mode_), m_, iw, w);
+      } else {
+        casadi_interpn_batch(res[0], ndim_, grid, get_ptr(offset_),
+                      values, arg[0], get_ptr(lookup_mode_), m_, batch_x_, iw, w);
+      }
     }
     return 0;
   }
@@ -98,10 +109,15 @@ namespace casadi {
   void LinearInterpolant::codegen_body(CodeGenerator& g) const {
     std::string values = has_parametric_values() ? g.arg(arg_values()) : g.constant(values_);
     std::string grid = has_parametric_grid() ? g.arg(arg_grid()) : g.constant(grid_);
-    g << "  if (res[0]) {\n"
-      << "    " << g.interpn("res[0]", ndim_, grid, g.constant(offset_),
-      values, "arg[0]", g.constant(lookup_mode_), m_,  "iw", "w") << "\n"
-      << "  }\n";
+    g << "  if (res[0]) {\n";
+    if (batch_x_==1) {
+      g << "    " << g.interpn("res[0]", ndim_, grid, g.constant(offset_),
+        values, "arg[0]", g.constant(lookup_mode_), m_,  "iw", "w") << "\n";
+    } else {
+      g << "    " << g.interpn_batch("res[0]", ndim_, grid, g.constant(offset_),
+        values, "arg[0]", g.constant(lookup_mode_), m_, batch_x_, "iw", "w") << "\n";
+    }
+    g << "  }\n";
   }
 
   Function LinearInterpolant::
@@ -137,6 +153,9 @@ namespace casadi {
     auto m = derivative_of_.get<LinearInterpolant>();
     alloc_w(2*m->ndim_ + m->m_, true);
     alloc_iw(2*m->ndim_, true);
+
+    // Gradient of one point, scattered into the block diagonal
+    if (m->batch_x_>1) alloc_w(m->ndim_*m->m_, true);
   }
 
   int LinearInterpolantJac::
@@ -146,8 +165,22 @@ namespace casadi {
     const double* values = has_parametric_values() ? arg[m->arg_values()] : get_ptr(m->values_);
     const double* grid = has_parametric_grid() ? arg[m->arg_grid()] : get_ptr(m->grid_);
 
-    casadi_interpn_grad(res[0], m->ndim_, grid, get_ptr(m->offset_),
-                      values, arg[0], get_ptr(m->lookup_mode_), m->m_, iw, w);
+    if (m->batch_x_==1) {
+      casadi_interpn_grad(res[0], m->ndim_, grid, get_ptr(m->offset_),
+                        values, arg[0], get_ptr(m->lookup_mode_), m->m_, iw, w);
+    } else if (res[0]) {
+      // Points are independent: block diagonal Jacobian
+      casadi_int nd = m->ndim_, nm = m->m_, nb = m->batch_x_;
+      double* grad = w; w += nd*nm;
+      casadi_clear(res[0], nd*nm*nb*nb);
+      for (casadi_int k=0; k<nb; ++k) {
+        casadi_interpn_grad(grad, nd, grid, get_ptr(m->offset_), values,
+                          arg[0] ? arg[0]+k*nd : nullptr, get_ptr(m->lookup_mode_), nm, iw, w);
+        for (casadi_int i=0; i<nd; ++i) {
+          casadi_copy(grad+i*nm, nm, res[0]+(k*nd+i)*nm*nb+k*nm);
+        }
+      }
+    }
     return 0;
   }
 
@@ -167,9 +200,26 @@ namespace casadi {
     std::string values = has_parametric_values() ? g.arg(m->arg_values()) : g.constant(m->values_);
     std::string grid = has_parametric_grid() ? g.arg(m->arg_grid()) : g.constant(m->grid_);
 
-    g << "  " << g.interpn_grad("res[0]", m->ndim_,
-      grid, g.constant(m->offset_), values,
-      "arg[0]", g.constant(m->lookup_mode_), m->m_, "iw", "w") << "\n";
+    if (m->batch_x_==1) {
+      g << "  " << g.interpn_grad("res[0]", m->ndim_,
+        grid, g.constant(m->offset_), values,
+        "arg[0]", g.constant(m->lookup_mode_), m->m_, "iw", "w") << "\n";
+    } else {
+      casadi_int nd = m->ndim_, nm = m->m_, nb = m->batch_x_;
+      g << "  if (res[0]) {\n"
+        << "    casadi_int k, i;\n"
+        << "    " << g.clear("res[0]", nd*nm*nb*nb) << "\n"
+        << "    for (k=0; k<" << nb << "; ++k) {\n"
+        << "      " << g.interpn_grad("w", nd, grid, g.constant(m->offset_), values,
+                                      "arg[0] ? arg[0]+k*" + str(nd) + " : 0",
+                                      g.constant(m->lookup_mode_), nm, "iw",
+                                      "w+" + str(nd*nm)) << "\n"
+        << "      for (i=0; i<" << nd << "; ++i) "
+        << g.copy("w+i*" + str(nm), nm,
+                  "res[0]+(k*" + str(nd) + "+i)*" + str(nm*nb) + "+k*" + str(nm)) << "\n"
+        << "    }\n"
+        << "  }\n";
+    }
   }
 
 
@@ -0,0 +1,526 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "linsol_krylov.hpp"
+#include "casadi/core/global_options.hpp"
+
+using namespace std;
+namespace casadi {
+
+  extern "C"
+  int CASADI_LINSOL_KRYLOV_EXPORT
+  casadi_register_linsol_krylov(LinsolInternal::Plugin* plugin) {
+    plugin->creator = LinsolKrylov::creator;
+    plugin->name = "krylov";
+    plugin->doc = LinsolKrylov::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &LinsolKrylov::options_;
+    plugin->deserialize = &LinsolKrylov::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_LINSOL_KRYLOV_EXPORT casadi_load_linsol_krylov() {
+    LinsolInternal::registerPlugin(casadi_register_linsol_krylov);
+  }
+
+  LinsolKrylov::LinsolKrylov(const std::string& name, const Sparsity& sp)
+    : LinsolInternal(name, sp) {
+  }
+
+  LinsolKrylov::~LinsolKrylov() {
+    clear_mem();
+  }
+
+  const Options LinsolKrylov::options_
+  = {{&LinsolInternal::options_},
+     {{"method",
+       {OT_STRING,
+        "Krylov method: 'gmres' (default), 'minres' (symmetric) or 'cg' (symmetric positive "
+        "definite)"}},
+      {"preconditioner",
+       {OT_STRING,
+        "Preconditioner: 'none' (default), 'jacobi' or 'ildl' (incomplete LDL^T without fill-in, "
+        "requires a symmetric sparsity pattern)"}},
+      {"preordering",
+       {OT_STRING,
+        "Preordering for the incomplete LDL^T: 'amd' (default), 'nested_dissection' or 'none'"}},
+      {"tol",
+       {OT_DOUBLE,
+        "Stopping tolerance on the relative residual norm [1e-10]"}},
+      {"max_iter",
+       {OT_INT,
+        "Maximum number of iterations per right-hand-side [1000]"}},
+      {"restart",
+       {OT_INT,
+        "Krylov subspace dimension before GMRES is restarted [30]"}},
+      {"operator",
+       {OT_FUNCTION,
+        "Matrix-free operator: function with a single (n-by-1) input and output "
+        "computing the product A*x. The nonzeros of A are then only used for preconditioning"}}
+     }
+  };
+
+  void LinsolKrylov::init(const Dict& opts) {
+    // Call the init method of the base class
+    LinsolInternal::init(opts);
+
+    // Default options
+    string method = "gmres", preconditioner = "none", preordering = "amd";
+    tol_ = 1e-10;
+    max_iter_ = 1000;
+    restart_ = 30;
+
+    // Read user options
+    for (auto&& op : opts) {
+      if (op.first=="method") {
+        method = op.second.to_string();
+      } else if (op.first=="preconditioner") {
+        preconditioner = op.second.to_string();
+      } else if (op.first=="preordering") {
+        preordering = op.second.to_string();
+      } else if (op.first=="tol") {
+        tol_ = op.second;
+      } else if (op.first=="max_iter") {
+        max_iter_ = op.second;
+      } else if (op.first=="restart") {
+        restart_ = op.second;
+      } else if (op.first=="operator") {
+        operator_ = op.second;
+      }
+    }
+
+    // Krylov method
+    if (method=="gmres") {
+      method_ = KRYLOV_GMRES;
+    } else if (method=="minres") {
+      method_ = KRYLOV_MINRES;
+    } else if (method=="cg") {
+      method_ = KRYLOV_CG;
+    } else {
+      casadi_error("Unknown method '" + method + "'. "
+                   "Valid options are 'gmres', 'minres' and 'cg'");
+    }
+    casadi_assert(restart_>=1, "'restart' must be positive");
+    casadi_assert(max_iter_>=1, "'max_iter' must be positive");
+
+    // Matrix-free operator
+    casadi_int n = nrow();
+    if (!operator_.is_null()) {
+      casadi_assert(operator_.n_in()==1 && operator_.n_out()==1,
+        "'operator' must have a single input and a single output");
+      casadi_assert(operator_.sparsity_in(0)==Sparsity::dense(n, 1)
+                    && operator_.sparsity_out(0)==Sparsity::dense(n, 1),
+        "'operator' must map a dense " + str(n) + "-by-1 vector to a dense "
+        + str(n) + "-by-1 vector");
+    } else if (method_!=KRYLOV_GMRES) {
+      casadi_assert(sp_.is_symmetric(), "'" + method + "' requires a symmetric matrix");
+    }
+
+    // Preconditioner
+    if (preconditioner=="none") {
+      pc_ = PC_NONE;
+    } else if (preconditioner=="jacobi") {
+      pc_ = PC_JACOBI;
+    } else if (preconditioner=="ildl") {
+      pc_ = PC_ILDL;
+    } else {
+      casadi_error("Unknown preconditioner '" + preconditioner + "'. "
+                   "Valid options are 'none', 'jacobi' and 'ildl'");
+    }
+
+    // Locate the diagonal entries
+    if (pc_==PC_JACOBI) {
+      diag_.resize(n);
+      const casadi_int *colind = sp_.colind(), *row = sp_.row();
+      for (casadi_int c=0; c<n; ++c) {
+        diag_[c] = -1;
+        for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+          if (row[k]==c) diag_[c] = k;
+        }
+      }
+    }
+
+    // Incomplete LDL^T, no fill-in
+    if (pc_==PC_ILDL) {
+      casadi_assert(sp_.is_symmetric(), "'ildl' preconditioner requires a symmetric matrix");
+      if (preordering=="amd") {
+        p_ = sp_.amd();
+      } else if (preordering=="nested_dissection") {
+        p_ = sp_.nested_dissection();
+      } else if (preordering=="none") {
+        p_ = range(n);
+      } else {
+        casadi_error("Unknown preordering '" + preordering + "'. "
+                     "Valid options are 'amd', 'nested_dissection' and 'none'");
+      }
+      std::vector<casadi_int> tmp;
+      sp_Lt_ = triu(sp_.sub(p_, p_, tmp), false);
+    }
+  }
+
+  int LinsolKrylov::init_mem(void* mem) const {
+    if (LinsolInternal::init_mem(mem)) return 1;
+    auto m = static_cast<LinsolKrylovMemory*>(mem);
+    casadi_int n = nrow();
+
+    // Preconditioner
+    if (pc_==PC_ILDL) {
+      m->l.resize(sp_Lt_.nnz());
+      m->d.resize(n);
+    } else if (pc_==PC_JACOBI) {
+      m->a_pc.resize(n);
+    }
+
+    // Krylov vectors, including one vector for the preconditioner
+    if (method_==KRYLOV_GMRES) {
+      m->w.resize((restart_ + 6) * n);
+      m->h.resize((restart_ + 1) * restart_);
+      m->g.resize(restart_ + 1);
+      m->cs.resize(restart_);
+      m->sn.resize(restart_);
+    } else {
+      m->w.resize(10 * n);
+    }
+
+    // Work vectors for the matrix-free operator
+    if (!operator_.is_null()) {
+      m->arg.resize(operator_.sz_arg());
+      m->res.resize(operator_.sz_res());
+      m->op_iw.resize(operator_.sz_iw());
+      m->op_w.resize(operator_.sz_w());
+    }
+
+    m->iter = 0;
+    m->residual = 0;
+    m->success = false;
+    return 0;
+  }
+
+  int LinsolKrylov::nfact(void* mem, const double* A) const {
+    auto m = static_cast<LinsolKrylovMemory*>(mem);
+    casadi_int n = nrow();
+    if (pc_==PC_JACOBI) {
+      for (casadi_int i=0; i<n; ++i) {
+        double a = diag_[i]>=0 ? fabs(A[diag_[i]]) : 0;
+        m->a_pc[i] = a==0 ? 1 : 1/a;
+      }
+    } else if (pc_==PC_ILDL) {
+      casadi_ldl(sp_, A, sp_Lt_, get_ptr(m->l), get_ptr(m->d), get_ptr(p_), get_ptr(m->w));
+      for (double& d : m->d) {
+        if (d==0 || !isfinite(d)) {
+          casadi_warning("Incomplete LDL^T preconditioner broke down");
+          return 1;
+        }
+        // MINRES and CG need a positive definite preconditioner
+        if (method_!=KRYLOV_GMRES) d = fabs(d);
+      }
+    }
+    return 0;
+  }
+
+  int LinsolKrylov::mv(LinsolKrylovMemory* m, const double* A, const double* x, double* y,
+                       bool tr) const {
+    if (operator_.is_null()) {
+      casadi_clear(y, nrow());
+      casadi_mv(A, sp_, x, y, tr);
+      return 0;
+    } else {
+      casadi_assert(!tr || method_!=KRYLOV_GMRES,
+        "Transposed solve with GMRES is not supported for a matrix-free 'operator'");
+      m->arg[0] = x;
+      m->res[0] = y;
+      return operator_(get_ptr(m->arg), get_ptr(m->res), get_ptr(m->op_iw), get_ptr(m->op_w));
+    }
+  }
+
+  void LinsolKrylov::precond(LinsolKrylovMemory* m, const double* r, double* z) const {
+    casadi_int n = nrow();
+    switch (pc_) {
+    case PC_NONE:
+      casadi_copy(r, n, z);
+      break;
+    case PC_JACOBI:
+      for (casadi_int i=0; i<n; ++i) z[i] = m->a_pc[i] * r[i];
+      break;
+    case PC_ILDL:
+      // The last Krylov vector is reserved for the preconditioner
+      casadi_copy(r, n, z);
+      casadi_ldl_solve(z, 1, sp_Lt_, get_ptr(m->l), get_ptr(m->d), get_ptr(p_),
+                       get_ptr(m->w) + m->w.size() - n);
+      break;
+    }
+  }
+
+  int LinsolKrylov::solve_cg(LinsolKrylovMemory* m, const double* A, double* b) const {
+    casadi_int n = nrow();
+    // Work vectors
+    double *x = get_ptr(m->w), *r = x + n, *z = r + n, *p = z + n, *q = p + n;
+    // Initial guess x = 0, residual r = b
+    casadi_clear(x, n);
+    casadi_copy(b, n, r);
+    double bnorm = casadi_norm_2(n, b), rnorm = bnorm;
+    casadi_int iter = 0;
+    if (bnorm>0) {
+      precond(m, r, z);
+      casadi_copy(z, n, p);
+      double rz = casadi_dot(n, r, z);
+      while (iter<max_iter_) {
+        iter++;
+        if (mv(m, A, p, q, false)) return 1;
+        double pq = casadi_dot(n, p, q);
+        if (pq<=0) break;  // not positive definite
+        double alpha = rz/pq;
+        casadi_axpy(n, alpha, p, x);
+        casadi_axpy(n, -alpha, q, r);
+        rnorm = casadi_norm_2(n, r);
+        if (rnorm<=tol_*bnorm) break;
+        precond(m, r, z);
+        double rz_new = casadi_dot(n, r, z);
+        double beta = rz_new/rz;
+        rz = rz_new;
+        casadi_scal(n, beta, p);
+        casadi_axpy(n, 1., z, p);
+      }
+    }
+    // Return solution
+    casadi_copy(x, n, b);
+    m->iter += iter;
+    m->residual = fmax(m->residual, bnorm>0 ? rnorm/bnorm : 0);
+    return bnorm>0 && rnorm>tol_*bnorm;
+  }
+
+  int LinsolKrylov::solve_minres(LinsolKrylovMemory* m, const double* A, double* b) const {
+    casadi_int n = nrow();
+    // Work vectors
+    double *x = get_ptr(m->w), *r1 = x + n, *r2 = r1 + n, *y = r2 + n, *v = y + n;
+    double *w = v + n, *w1 = w + n, *w2 = w1 + n;
+    // Initial guess x = 0, residual r1 = b
+    casadi_clear(x, n);
+    casadi_copy(b, n, r1);
+    precond(m, r1, y);
+    double beta1 = casadi_dot(n, r1, y);
+    if (beta1<0) return 1;  // preconditioner not positive definite
+    beta1 = sqrt(beta1);
+    // Lanczos and QR state, cf. Paige & Saunders (1975)
+    double oldb = 0, beta = beta1, dbar = 0, epsln = 0, phibar = beta1, cs = -1, sn = 0;
+    casadi_clear(w, n);
+    casadi_clear(w2, n);
+    casadi_copy(r1, n, r2);
+    casadi_int iter = 0;
+    while (phibar>tol_*beta1 && iter<max_iter_) {
+      iter++;
+      // Lanczos step
+      double s = 1/beta;
+      for (casadi_int i=0; i<n; ++i) v[i] = s*y[i];
+      if (mv(m, A, v, y, false)) return 1;
+      if (iter>=2) casadi_axpy(n, -beta/oldb, r1, y);
+      double alfa = casadi_dot(n, v, y);
+      casadi_axpy(n, -alfa/beta, r2, y);
+      casadi_copy(r2, n, r1);
+      casadi_copy(y, n, r2);
+      precond(m, r2, y);
+      oldb = beta;
+      beta = casadi_dot(n, r2, y);
+      if (beta<0) return 1;  // preconditioner not positive definite
+      beta = sqrt(beta);
+      // Apply previous rotation, compute the next one
+      double oldeps = epsln;
+      double delta = cs*dbar + sn*alfa;
+      double gbar = sn*dbar - cs*alfa;
+      epsln = sn*beta;
+      dbar = -cs*beta;
+      double gamma = sqrt(gbar*gbar + beta*beta);
+      gamma = fmax(gamma, eps);
+      cs = gbar/gamma;
+      sn = beta/gamma;
+      double phi = cs*phibar;
+      phibar = sn*phibar;
+      // Update solution
+      double *tmp = w1;
+      w1 = w2;
+      w2 = w;
+      w = tmp;
+      for (casadi_int i=0; i<n; ++i) w[i] = (v[i] - oldeps*w1[i] - delta*w2[i])/gamma;
+      casadi_axpy(n, phi, w, x);
+      if (beta==0) break;  // invariant subspace found, solution is exact
+    }
+    // Return solution
+    casadi_copy(x, n, b);
+    m->iter += iter;
+    m->residual = fmax(m->residual, beta1>0 ? phibar/beta1 : 0);
+    return beta1>0 && phibar>tol_*beta1;
+  }
+
+  int LinsolKrylov::solve_gmres(LinsolKrylovMemory* m, const double* A, double* b,
+                                bool tr) const {
+    casadi_int n = nrow(), k = restart_;
+    // Work vectors
+    double *x = get_ptr(m->w), *r = x + n, *z = r + n, *v = z + n;
+    double *h = get_ptr(m->h), *g = get_ptr(m->g), *cs = get_ptr(m->cs), *sn = get_ptr(m->sn);
+    // Initial guess x = 0
+    casadi_clear(x, n);
+    double bnorm = casadi_norm_2(n, b), rnorm = bnorm;
+    casadi_int iter = 0;
+    while (bnorm>0 && iter<max_iter_) {
+      // Residual r = b - A*x
+      if (mv(m, A, x, r, tr)) return 1;
+      for (casadi_int i=0; i<n; ++i) r[i] = b[i] - r[i];
+      rnorm = casadi_norm_2(n, r);
+      if (rnorm<=tol_*bnorm) break;
+      // First basis vector
+      for (casadi_int i=0; i<n; ++i) v[i] = r[i]/rnorm;
+      casadi_clear(g, k+1);
+      g[0] = rnorm;
+      // Arnoldi process
+      casadi_int j;
+      for (j=0; j<k && iter<max_iter_; ++j) {
+        iter++;
+        double *vj = v + j*n, *vj1 = vj + n, *hj = h + j*(k+1);
+        // Right preconditioning: vj1 = A*(M\vj)
+        precond(m, vj, z);
+        if (mv(m, A, z, vj1, tr)) return 1;
+        // Modified Gram-Schmidt
+        for (casadi_int i=0; i<=j; ++i) {
+          hj[i] = casadi_dot(n, vj1, v + i*n);
+          casadi_axpy(n, -hj[i], v + i*n, vj1);
+        }
+        hj[j+1] = casadi_norm_2(n, vj1);
+        if (hj[j+1]!=0) casadi_scal(n, 1/hj[j+1], vj1);
+        // Apply previous Givens rotations to the new column
+        for (casadi_int i=0; i<j; ++i) {
+          double t = cs[i]*hj[i] + sn[i]*hj[i+1];
+          hj[i+1] = -sn[i]*hj[i] + cs[i]*hj[i+1];
+          hj[i] = t;
+        }
+        // Eliminate the subdiagonal entry
+        double nu = sqrt(hj[j]*hj[j] + hj[j+1]*hj[j+1]);
+        cs[j] = nu==0 ? 1 : hj[j]/nu;
+        sn[j] = nu==0 ? 0 : hj[j+1]/nu;
+        hj[j] = nu;
+        hj[j+1] = 0;
+        g[j+1] = -sn[j]*g[j];
+        g[j] = cs[j]*g[j];
+        // Residual norm estimate
+        if (fabs(g[j+1])<=tol_*bnorm) {
+          j++;
+          break;
+        }
+      }
+      // Solve the upper triangular least-squares system, overwriting g
+      for (casadi_int i=j-1; i>=0; --i) {
+        for (casadi_int l=i+1; l<j; ++l) g[i] -= h[l*(k+1) + i]*g[l];
+        g[i] /= h[i*(k+1) + i];
+      }
+      // Update solution, x += M\(V*y)
+      casadi_clear(r, n);
+      for (casadi_int i=0; i<j; ++i) casadi_axpy(n, g[i], v + i*n, r);
+      precond(m, r, z);
+      casadi_axpy(n, 1., z, x);
+    }
+    // Final residual
+    if (bnorm>0 && iter>=max_iter_) {
+      if (mv(m, A, x, r, tr)) return 1;
+      for (casadi_int i=0; i<n; ++i) r[i] = b[i] - r[i];
+      rnorm = casadi_norm_2(n, r);
+    }
+    // Return solution
+    casadi_copy(x, n, b);
+    m->iter += iter;
+    m->residual = fmax(m->residual, bnorm>0 ? rnorm/bnorm : 0);
+    return bnorm>0 && rnorm>tol_*bnorm;
+  }
+
+  int LinsolKrylov::solve(void* mem, const double* A, double* x, casadi_int nrhs,
+                          bool tr) const {
+    auto m = static_cast<LinsolKrylovMemory*>(mem);
+    m->iter = 0;
+    m->residual = 0;
+    m->success = true;
+    for (casadi_int k=0; k<nrhs; ++k) {
+      int flag;
+      switch (method_) {
+      case KRYLOV_CG:
+        flag = solve_cg(m, A, x);
+        break;
+      case KRYLOV_MINRES:
+        flag = solve_minres(m, A, x);
+        break;
+      default:
+        flag = solve_gmres(m, A, x, tr);
+      }
+      if (flag) {
+        m->success = false;
+        if (verbose_) {
+          casadi_message("Krylov method failed to converge: relative residual "
+                         + str(m->residual) + " after " + str(m->iter) + " iterations");
+        }
+        return 1;
+      }
+      x += nrow();
+    }
+    return 0;
+  }
+
+  Dict LinsolKrylov::get_stats(void* mem) const {
+    Dict stats = LinsolInternal::get_stats(mem);
+    auto m = static_cast<LinsolKrylovMemory*>(mem);
+    stats["iter_count"] = m->iter;
+    stats["residual"] = m->residual;
+    stats["success"] = m->success;
+    return stats;
+  }
+
+  LinsolKrylov::LinsolKrylov(DeserializingStream& s) : LinsolInternal(s) {
+    s.version("LinsolKrylov", 1);
+    int method, pc;
+    s.unpack("LinsolKrylov::method", method);
+    s.unpack("LinsolKrylov::pc", pc);
+    method_ = static_cast<Method>(method);
+    pc_ = static_cast<Preconditioner>(pc);
+    s.unpack("LinsolKrylov::tol", tol_);
+    s.unpack("LinsolKrylov::max_iter", max_iter_);
+    s.unpack("LinsolKrylov::restart", restart_);
+    s.unpack("LinsolKrylov::operator", operator_);
+    s.unpack("LinsolKrylov::p", p_);
+    s.unpack("LinsolKrylov::sp_Lt", sp_Lt_);
+    s.unpack("LinsolKrylov::diag", diag_);
+  }
+
+  void LinsolKrylov::serialize_body(SerializingStream &s) const {
+    LinsolInternal::serialize_body(s);
+    s.version("LinsolKrylov", 1);
+    s.pack("LinsolKrylov::method", static_cast<int>(method_));
+    s.pack("LinsolKrylov::pc", static_cast<int>(pc_));
+    s.pack("LinsolKrylov::tol", tol_);
+    s.pack("LinsolKrylov::max_iter", max_iter_);
+    s.pack("LinsolKrylov::restart", restart_);
+    s.pack("LinsolKrylov::operator", operator_);
+    s.pack("LinsolKrylov::p", p_);
+    s.pack("LinsolKrylov::sp_Lt", sp_Lt_);
+    s.pack("LinsolKrylov::diag", diag_);
+  }
+
+} // namespace casadi
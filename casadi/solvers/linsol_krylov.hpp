@@ -0,0 +1,161 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_LINSOL_KRYLOV_HPP
+#define CASADI_LINSOL_KRYLOV_HPP
+
+/** \defgroup plugin_Linsol_krylov
+  * Iterative linear solver using Krylov subspace methods (GMRES, MINRES or CG),
+  * optionally matrix-free and with Jacobi or incomplete LDL^T preconditioning
+*/
+
+/** \pluginsection{Linsol,krylov} */
+
+/// \cond INTERNAL
+#include "casadi/core/linsol_internal.hpp"
+#include <casadi/solvers/casadi_linsol_krylov_export.h>
+
+namespace casadi {
+  struct CASADI_LINSOL_KRYLOV_EXPORT LinsolKrylovMemory : public LinsolMemory {
+    // Preconditioner: incomplete factors or inverse diagonal
+    std::vector<double> l, d, a_pc;
+    // Krylov vectors and small dense matrices
+    std::vector<double> w, h, g, cs, sn;
+    // Work vectors for the matrix-free operator
+    std::vector<const double*> arg;
+    std::vector<double*> res;
+    std::vector<casadi_int> op_iw;
+    std::vector<double> op_w;
+    // Statistics of the last solve
+    casadi_int iter;
+    double residual;
+    bool success;
+  };
+
+  /** \brief \pluginbrief{LinsolInternal,krylov}
+   * @copydoc LinsolInternal_doc
+   * @copydoc plugin_LinsolInternal_krylov
+   */
+  class CASADI_LINSOL_KRYLOV_EXPORT LinsolKrylov : public LinsolInternal {
+  public:
+
+    // Create a linear solver given a sparsity pattern and a number of right hand sides
+    LinsolKrylov(const std::string& name, const Sparsity& sp);
+
+    /** \brief  Create a new LinsolInternal */
+    static LinsolInternal* creator(const std::string& name, const Sparsity& sp) {
+      return new LinsolKrylov(name, sp);
+    }
+
+    // Destructor
+    ~LinsolKrylov() override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    // Initialize the solver
+    void init(const Dict& opts) override;
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new LinsolKrylovMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override { delete static_cast<LinsolKrylovMemory*>(mem);}
+
+    // Factorize the linear system (set up the preconditioner)
+    int nfact(void* mem, const double* A) const override;
+
+    // Solve the linear system
+    int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "krylov";}
+
+    // Get name of the class
+    std::string class_name() const override { return "LinsolKrylov";}
+
+    // Matrix-vector product y = A*x or y = A'*x
+    int mv(LinsolKrylovMemory* m, const double* A, const double* x, double* y, bool tr) const;
+
+    // Apply the preconditioner, z = M\r
+    void precond(LinsolKrylovMemory* m, const double* r, double* z) const;
+
+    // Preconditioned conjugate gradients, b is overwritten with the solution
+    int solve_cg(LinsolKrylovMemory* m, const double* A, double* b) const;
+
+    // Preconditioned MINRES, b is overwritten with the solution
+    int solve_minres(LinsolKrylovMemory* m, const double* A, double* b) const;
+
+    // Restarted GMRES with right preconditioning, b is overwritten with the solution
+    int solve_gmres(LinsolKrylovMemory* m, const double* A, double* b, bool tr) const;
+
+    /// Krylov method and preconditioner
+    enum Method {KRYLOV_GMRES, KRYLOV_MINRES, KRYLOV_CG};
+    enum Preconditioner {PC_NONE, PC_JACOBI, PC_ILDL};
+    Method method_;
+    Preconditioner pc_;
+
+    ///@{
+    // Options
+    double tol_;
+    casadi_int max_iter_, restart_;
+    Function operator_;
+    ///@}
+
+    // Incomplete LDL^T: permutation and sparsity pattern of L^T
+    std::vector<casadi_int> p_;
+    Sparsity sp_Lt_;
+
+    // Nonzero index of the diagonal entries of A, -1 if structurally zero
+    std::vector<casadi_int> diag_;
+
+    /** \brief Serialize an object without type information */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new LinsolKrylov(s); }
+
+  protected:
+    /** \brief Deserializing constructor */
+    explicit LinsolKrylov(DeserializingStream& s);
+  };
+
+} // namespace casadi
+
+/// \endcond
+
+#endif // CASADI_LINSOL_KRYLOV_HPP
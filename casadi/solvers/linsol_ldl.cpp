@@ -60,8 +60,12 @@ namespace casadi {
       {OT_BOOL,
        "Incomplete factorization, without any fill-in"}},
       {"preordering",
-       {OT_BOOL,
-       "Approximate minimal degree (AMD) preordering"}}
+       {OT_STRING,
+       "Fill-reducing preordering: 'amd' (approximate minimal degree, default), "
+       "'nested_dissection' or 'none'"}},
+      {"nd_leaf_size",
+       {OT_INT,
+       "Subgraph size below which nested dissection switches to AMD [64]"}}
      }
   };
 
@@ -71,32 +75,45 @@ namespace casadi {
 
     // Default options
     incomplete_ = false;
-    amd_ = true;
+    preordering_ = "amd";
+    casadi_int nd_leaf_size = 64;
 
     // Read user options
     for (auto&& op : opts) {
       if (op.first=="incomplete") {
         incomplete_ = op.second;
-      } else if (op.first=="amd") {
-        amd_ = op.second;
+      } else if (op.first=="preordering") {
+        preordering_ = op.second.to_string();
+      } else if (op.first=="nd_leaf_size") {
+        nd_leaf_size = op.second;
       }
     }
 
+    // Fill-reducing permutation
+    if (preordering_=="amd") {
+      p_ = sp_.amd();
+    } else if (preordering_=="nested_dissection") {
+      p_ = sp_.nested_dissection(nd_leaf_size);
+    } else if (preordering_=="none") {
+      p_ = range(sp_.size1());
+    } else {
+      casadi_error("Unknown preordering '" + preordering_ + "'. "
+                   "Valid options are 'amd', 'nested_dissection' and 'none'");
+    }
+
     // Symbolic factorization
+    std::vector<casadi_int> tmp;
+    Sparsity Aperm = sp_.sub(p_, p_, tmp);
     if (incomplete_) {
-      if (amd_) {
-        // Incomplete LDL^T, AMD permutation
-        p_ = sp_.amd();
-        std::vector<casadi_int> tmp;
-        Sparsity Aperm = sp_.sub(p_, p_, tmp);
-        sp_Lt_ = triu(Aperm, false);  // no fill-in
-      } else {
-        p_ = range(sp_.size1());  // no reordering
-        sp_Lt_ = triu(sp_, false);  // no fill-in
-      }
+      sp_Lt_ = triu(Aperm, false);  // no fill-in
     } else {
-      // Regular LDL^T
-      sp_Lt_ = sp_.ldl(p_, amd_);
+      sp_Lt_ = Aperm.ldl(tmp, false);
+    }
+
+    if (verbose_) {
+      casadi_message("LDL^T with " + preordering_ + " preordering: "
+                     + str(sp_Lt_.nnz()) + " nonzeros in L, "
+                     + str(sp_Lt_.nnz() - sp_.nnz_upper(true)) + " fill-in");
     }
   }
 
@@ -113,6 +130,14 @@ namespace casadi {
     return 0;
   }
 
+  Dict LinsolLdl::get_stats(void* mem) const {
+    Dict stats = LinsolInternal::get_stats(mem);
+    stats["preordering"] = preordering_;
+    stats["nnz_L"] = sp_Lt_.nnz();
+    stats["fill_in"] = sp_Lt_.nnz() - sp_.nnz_upper(true);
+    return stats;
+  }
+
   int LinsolLdl::sfact(void* mem, const double* A) const {
     return 0;
   }
@@ -175,16 +200,25 @@ namespace casadi {
   }
 
   LinsolLdl::LinsolLdl(DeserializingStream& s) : LinsolInternal(s) {
-    s.version("LinsolLdl", 1);
+    int version = s.version("LinsolLdl", 1, 2);
     s.unpack("LinsolLdl::p", p_);
     s.unpack("LinsolLdl::sp_Lt", sp_Lt_);
+    if (version>1) {
+      s.unpack("LinsolLdl::incomplete", incomplete_);
+      s.unpack("LinsolLdl::preordering", preordering_);
+    } else {
+      incomplete_ = false;
+      preordering_ = "amd";
+    }
   }
 
   void LinsolLdl::serialize_body(SerializingStream &s) const {
     LinsolInternal::serialize_body(s);
-    s.version("LinsolLdl", 1);
+    s.version("LinsolLdl", 2);
     s.pack("LinsolLdl::p", p_);
     s.pack("LinsolLdl::sp_Lt", sp_Lt_);
+    s.pack("LinsolLdl::incomplete", incomplete_);
+    s.pack("LinsolLdl::preordering", preordering_);
   }
 
 } // namespace casadi
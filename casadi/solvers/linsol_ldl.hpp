@@ -90,6 +90,9 @@ namespace casadi {
     void generate(CodeGenerator& g, const std::string& A, const std::string& x,
                   casadi_int nrhs, bool tr) const override;
 
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
     /// Number of negative eigenvalues
     casadi_int neig(void* mem, const double* A) const override;
 
@@ -111,7 +114,8 @@ namespace casadi {
 
     ///@{
     // Options
-    bool incomplete_, amd_;
+    bool incomplete_;
+    std::string preordering_;
     ///@}
 
     /** \brief Serialize an object without type information */
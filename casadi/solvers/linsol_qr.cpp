@@ -61,7 +61,14 @@ namespace casadi {
         "Minimum R entry before singularity is declared [1e-12]"}},
       {"cache",
        {OT_DOUBLE,
-        "Amount of factorisations to remember (thread-local) [0]"}}
+        "Amount of factorisations to remember (thread-local) [0]"}},
+      {"preordering",
+       {OT_STRING,
+        "Fill-reducing column preordering, applied to the pattern of A'*A: "
+        "'amd' (approximate minimal degree, default), 'nested_dissection' or 'none'"}},
+      {"nd_leaf_size",
+       {OT_INT,
+        "Subgraph size below which nested dissection switches to AMD [64]"}}
      }
   };
 
@@ -72,16 +79,40 @@ namespace casadi {
     // Read options
     eps_ = 1e-12;
     n_cache_ = 0;
+    preordering_ = "amd";
+    casadi_int nd_leaf_size = 64;
     for (auto&& op : opts) {
       if (op.first=="eps") {
         eps_ = op.second;
       } else if (op.first=="cache") {
         n_cache_ = op.second;
+      } else if (op.first=="preordering") {
+        preordering_ = op.second.to_string();
+      } else if (op.first=="nd_leaf_size") {
+        nd_leaf_size = op.second;
       }
     }
 
     // Symbolic factorization
-    sp_.qr_sparse(sp_v_, sp_r_, prinv_, pc_);
+    if (preordering_=="amd") {
+      sp_.qr_sparse(sp_v_, sp_r_, prinv_, pc_, true);
+    } else if (preordering_=="nested_dissection") {
+      pc_ = mtimes(sp_.T(), sp_).nested_dissection(nd_leaf_size);
+      std::vector<casadi_int> tmp;
+      Sparsity Aperm = sp_.sub(range(nrow()), pc_, tmp);
+      Aperm.qr_sparse(sp_v_, sp_r_, prinv_, tmp, false);
+    } else if (preordering_=="none") {
+      sp_.qr_sparse(sp_v_, sp_r_, prinv_, pc_, false);
+    } else {
+      casadi_error("Unknown preordering '" + preordering_ + "'. "
+                   "Valid options are 'amd', 'nested_dissection' and 'none'");
+    }
+
+    if (verbose_) {
+      casadi_message("QR with " + preordering_ + " preordering: "
+                     + str(sp_v_.nnz()) + " nonzeros in V, "
+                     + str(sp_r_.nnz()) + " nonzeros in R");
+    }
   }
 
   void LinsolQr::finalize() {
@@ -163,6 +194,14 @@ namespace casadi {
     return 0;
   }
 
+  Dict LinsolQr::get_stats(void* mem) const {
+    Dict stats = LinsolInternal::get_stats(mem);
+    stats["preordering"] = preordering_;
+    stats["nnz_V"] = sp_v_.nnz();
+    stats["nnz_R"] = sp_r_.nnz();
+    return stats;
+  }
+
   void LinsolQr::generate(CodeGenerator& g, const std::string& A, const std::string& x,
                           casadi_int nrhs, bool tr) const {
     // Codegen the integer vectors
@@ -219,7 +258,7 @@ namespace casadi {
   }
 
   LinsolQr::LinsolQr(DeserializingStream& s) : LinsolInternal(s) {
-    int version = s.version("LinsolQr", 1, 2);
+    int version = s.version("LinsolQr", 1, 3);
     s.unpack("LinsolQr::prinv", prinv_);
     s.unpack("LinsolQr::pc", pc_);
     s.unpack("LinsolQr::sp_v", sp_v_);
@@ -230,17 +269,23 @@ namespace casadi {
     } else {
       n_cache_ = 1;
     }
+    if (version>2) {
+      s.unpack("LinsolQr::preordering", preordering_);
+    } else {
+      preordering_ = "amd";
+    }
   }
 
   void LinsolQr::serialize_body(SerializingStream &s) const {
     LinsolInternal::serialize_body(s);
-    s.version("LinsolQr", 2);
+    s.version("LinsolQr", 3);
     s.pack("LinsolQr::prinv", prinv_);
     s.pack("LinsolQr::pc", pc_);
     s.pack("LinsolQr::sp_v", sp_v_);
     s.pack("LinsolQr::sp_r", sp_r_);
     s.pack("LinsolQr::eps", eps_);
     s.pack("LinsolQr::n_cache", n_cache_);
+    s.pack("LinsolQr::preordering", preordering_);
   }
 
 } // namespace casadi
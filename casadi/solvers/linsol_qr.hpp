@@ -93,6 +93,9 @@ namespace casadi {
     // Solve the linear system
     int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
 
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
     /// Generate C code
     void generate(CodeGenerator& g, const std::string& A, const std::string& x,
                   casadi_int nrhs, bool tr) const override;
@@ -111,6 +114,9 @@ namespace casadi {
     Sparsity sp_v_, sp_r_;
     double eps_;
 
+    /// Fill-reducing column preordering
+    std::string preordering_;
+
     /// Cache size
     casadi_int n_cache_;
     casadi_int cache_stride_;
@@ -70,7 +70,19 @@ namespace casadi {
         "Print information about each iteration"}},
       {"line_search",
        {OT_BOOL,
-        "Enable line-search (default: true)"}}
+        "Enable line-search (default: true)"}},
+      {"jacobian_reuse",
+       {OT_BOOL,
+        "Simplified Newton: keep the factorized Jacobian, also between calls, "
+        "and only refresh it when the residual does not contract sufficiently (default: false)"}},
+      {"contraction_tol",
+       {OT_DOUBLE,
+        "Refresh a reused Jacobian when max(|F|) decreases by less than this "
+        "factor in an iteration (default: 0.5)"}},
+      {"max_broyden",
+       {OT_INT,
+        "Maximum number of Broyden updates of a reused Jacobian before it is refreshed. "
+        "With 0 (default), the Jacobian is used without updates"}}
      }
   };
 
@@ -85,6 +97,9 @@ namespace casadi {
     abstolStep_ = 1e-12;
     print_iteration_ = false;
     line_search_ = true;
+    jacobian_reuse_ = false;
+    contraction_tol_ = 0.5;
+    max_broyden_ = 0;
 
     // Read options
     for (auto&& op : opts) {
@@ -98,6 +113,12 @@ namespace casadi {
         print_iteration_ = op.second;
       } else if (op.first=="line_search") {
         line_search_ = op.second;
+      } else if (op.first=="jacobian_reuse") {
+        jacobian_reuse_ = op.second;
+      } else if (op.first=="contraction_tol") {
+        contraction_tol_ = op.second;
+      } else if (op.first=="max_broyden") {
+        max_broyden_ = op.second;
       }
     }
 
@@ -105,8 +126,11 @@ namespace casadi {
                           "Newton: the supplied f must have at least one input.");
     casadi_assert(!linsol_.is_null(),
                           "Newton::init: linear_solver must be supplied");
+    casadi_assert(max_broyden_==0 || jacobian_reuse_,
+                          "Newton::init: max_broyden requires jacobian_reuse");
 
-    set_function(oracle_, "g");
+    ind_g_ = set_function(oracle_, "g");
+    ind_jac_f_z_ = function_index("jac_f_z");
 
 
     // Allocate memory
@@ -114,7 +138,8 @@ namespace casadi {
     alloc_w(n_, true); // F
     alloc_w(n_, true); // dx trial
     alloc_w(n_, true); // F trial
-    alloc_w(sp_jac_.nnz(), true); // J
+    if (!jacobian_reuse_) alloc_w(sp_jac_.nnz(), true); // J
+    alloc_w(n_*max_broyden_, true); // Broyden steps
   }
 
  void Newton::set_work(void* mem, const double**& arg, double**& res,
@@ -125,20 +150,31 @@ namespace casadi {
      m->f = w; w += n_;
      m->x_trial = w; w += n_;
      m->f_trial = w; w += n_;
-     m->jac = w; w += sp_jac_.nnz();
+     if (jacobian_reuse_) {
+       m->jac = get_ptr(m->jac_reuse);
+     } else {
+       m->jac = w; w += sp_jac_.nnz();
+     }
+     m->s = w; w += n_*max_broyden_;
   }
 
   int Newton::solve(void* mem) const {
     auto m = static_cast<NewtonMemory*>(mem);
 
-    scoped_checkout<Linsol> mem_linsol(linsol_);
-
     // Get the initial guess
     casadi_copy(m->iarg[iin_], n_, m->x);
 
     // Perform the Newton iterations
     m->iter=0;
+    m->n_jac = m->n_fact = m->n_broyden = 0;
     bool success = true;
+
+    // Jacobian needs to be (re)evaluated and factorized
+    bool refresh = !(jacobian_reuse_ && m->jac_valid);
+    // Residual norm in the previous iteration
+    double abstol_prev = numeric_limits<double>::infinity();
+    // Number of stored Broyden steps
+    casadi_int nb = 0;
     while (true) {
       // Break if maximum number of iterations already reached
       if (m->iter >= max_iter_) {
@@ -152,13 +188,20 @@ namespace casadi {
       // Start a new iteration
       m->iter++;
 
-      // Use x to evaluate g and J
+      // Use x to evaluate g, and J unless reused
       copy_n(m->iarg, n_in_, m->arg);
       m->arg[iin_] = m->x;
-      m->res[0] = m->jac;
-      copy_n(m->ires, n_out_, m->res+1);
-      m->res[1+iout_] = m->f;
-      calc_function(m, "jac_f_z");
+      if (refresh) {
+        m->res[0] = m->jac;
+        copy_n(m->ires, n_out_, m->res+1);
+        m->res[1+iout_] = m->f;
+        calc_function(m, ind_jac_f_z_);
+        m->n_jac++;
+      } else {
+        copy_n(m->ires, n_out_, m->res);
+        m->res[iout_] = m->f;
+        calc_function(m, ind_g_);
+      }
 
       // Check convergence
       double abstol = 0;
@@ -172,9 +215,38 @@ namespace casadi {
         }
       }
 
+      // Refresh a reused Jacobian if the contraction rate is insufficient
+      if (!refresh && !(abstol <= contraction_tol_*abstol_prev)) {
+        m->res[0] = m->jac;
+        copy_n(m->ires, n_out_, m->res+1);
+        m->res[1+iout_] = m->f;
+        calc_function(m, ind_jac_f_z_);
+        m->n_jac++;
+        refresh = true;
+      }
+      abstol_prev = abstol;
+
       // Factorize the linear solver with J
-      linsol_.nfact(m->jac, mem_linsol);
-      linsol_.solve(m->jac, m->f, 1, false, mem_linsol);
+      if (refresh) {
+        linsol_.nfact(m->jac, m->mem_linsol);
+        m->n_fact++;
+        m->jac_valid = true;
+        nb = 0;
+      }
+      linsol_.solve(m->jac, m->f, 1, false, m->mem_linsol);
+
+      // Broyden update of the step, cf. Kelley (1995), Algorithm brsol
+      if (nb>0) {
+        // z = -B0\F, updated with the stored steps
+        casadi_scal(n_, -1., m->f);
+        for (casadi_int j=0; j+1<nb; ++j) {
+          double* sj = m->s + j*n_;
+          casadi_axpy(n_, casadi_dot(n_, sj, m->f)/casadi_dot(n_, sj, sj), sj + n_, m->f);
+        }
+        double* sl = m->s + (nb-1)*n_;
+        casadi_scal(n_, -1./(1 - casadi_dot(n_, sl, m->f)/casadi_dot(n_, sl, sl)), m->f);
+        m->n_broyden++;
+      }
 
       // Check convergence again
       double abstolStep=0;
@@ -188,8 +260,9 @@ namespace casadi {
         }
       }
 
+      // Line search only with an up-to-date Jacobian, poor steps otherwise trigger a refresh
       double alpha = 1;
-      if (line_search_) {
+      if (line_search_ && refresh) {
         copy_n(m->iarg, n_in_, m->arg);
         m->arg[iin_] = m->x_trial;
         copy_n(m->ires, n_out_, m->res);
@@ -198,7 +271,7 @@ namespace casadi {
           // Xtrial = Xk - alpha*J^(-1) F
           copy_n(m->x, n_, m->x_trial);
           casadi_axpy(n_, -alpha, m->f, m->x_trial);
-          calc_function(m, "g");
+          calc_function(m, ind_g_);
 
           double abstol_trial = casadi_norm_inf(n_, m->f_trial);
           if (abstol_trial<=(1-alpha/2)*abstol) {
@@ -219,6 +292,20 @@ namespace casadi {
         casadi_axpy(n_, -alpha, m->f, m->x);
       }
 
+      // Store the step for Broyden updates, only full steps are supported
+      if (max_broyden_>0) {
+        if (alpha==1 && nb<max_broyden_) {
+          casadi_copy(m->f, n_, m->s + nb*n_);
+          casadi_scal(n_, -1., m->s + nb*n_);
+          nb++;
+        } else {
+          nb = 0;
+        }
+      }
+
+      // Keep the Jacobian for the next iteration, if allowed
+      refresh = !jacobian_reuse_ || (max_broyden_>0 && nb==0 && alpha==1);
+
       if (print_iteration_) {
         // Only print iteration header once in a while
         if ((m->iter-1) % 10 ==0) {
@@ -271,35 +358,62 @@ namespace casadi {
     auto m = static_cast<NewtonMemory*>(mem);
     m->return_status = "";
     m->iter = 0;
+    m->n_jac = m->n_fact = m->n_broyden = 0;
+    if (jacobian_reuse_) m->jac_reuse.resize(sp_jac_.nnz());
+    m->jac_valid = false;
+    m->mem_linsol = linsol_.checkout();
     return 0;
   }
 
+  void Newton::free_mem(void *mem) const {
+    auto m = static_cast<NewtonMemory*>(mem);
+    linsol_.release(m->mem_linsol);
+    delete m;
+  }
+
   Dict Newton::get_stats(void* mem) const {
     Dict stats = Rootfinder::get_stats(mem);
     auto m = static_cast<NewtonMemory*>(mem);
     stats["return_status"] = m->return_status;
     stats["iter_count"] = m->iter;
+    stats["n_jac"] = m->n_jac;
+    stats["n_fact"] = m->n_fact;
+    stats["n_broyden"] = m->n_broyden;
     return stats;
   }
 
 
   Newton::Newton(DeserializingStream& s) : Rootfinder(s) {
-    s.version("Newton", 1);
+    int version = s.version("Newton", 1, 2);
     s.unpack("Newton::max_iter", max_iter_);
     s.unpack("Newton::abstol", abstol_);
     s.unpack("Newton::abstolStep", abstolStep_);
     s.unpack("Newton::print_iteration", print_iteration_);
     s.unpack("Newton::line_search", line_search_);
+    if (version>1) {
+      s.unpack("Newton::jacobian_reuse", jacobian_reuse_);
+      s.unpack("Newton::contraction_tol", contraction_tol_);
+      s.unpack("Newton::max_broyden", max_broyden_);
+    } else {
+      jacobian_reuse_ = false;
+      contraction_tol_ = 0.5;
+      max_broyden_ = 0;
+    }
+    ind_g_ = function_index("g");
+    ind_jac_f_z_ = function_index("jac_f_z");
   }
 
   void Newton::serialize_body(SerializingStream &s) const {
     Rootfinder::serialize_body(s);
-    s.version("Newton", 1);
+    s.version("Newton", 2);
     s.pack("Newton::max_iter", max_iter_);
     s.pack("Newton::abstol", abstol_);
     s.pack("Newton::abstolStep", abstolStep_);
     s.pack("Newton::print_iteration", print_iteration_);
     s.pack("Newton::line_search", line_search_);
+    s.pack("Newton::jacobian_reuse", jacobian_reuse_);
+    s.pack("Newton::contraction_tol", contraction_tol_);
+    s.pack("Newton::max_broyden", max_broyden_);
   }
 
 } // namespace casadi
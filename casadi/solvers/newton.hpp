@@ -51,10 +51,20 @@ namespace casadi {
     double* f_trial;
     // Current Jacobian
     double* jac;
+    // Broyden steps since the last factorization
+    double* s;
     // Return status
     const char* return_status;
     // Number of iterations
     casadi_int iter;
+    // Number of Jacobian evaluations and factorizations
+    casadi_int n_jac, n_fact;
+    // Number of Broyden updates
+    casadi_int n_broyden;
+    // Jacobian and linear solver memory, kept between calls for jacobian_reuse
+    std::vector<double> jac_reuse;
+    bool jac_valid;
+    int mem_linsol;
   };
 
   /** \brief \pluginbrief{Rootfinder,newton}
@@ -100,7 +110,7 @@ namespace casadi {
     int init_mem(void* mem) const override;
 
     /** \brief Free memory block */
-    void free_mem(void *mem) const override { delete static_cast<NewtonMemory*>(mem);}
+    void free_mem(void *mem) const override;
 
     /** \brief Set the (persistent) work vectors */
     void set_work(void* mem, const double**& arg, double**& res,
@@ -128,6 +138,9 @@ namespace casadi {
     /// Maximum number of Newton iterations
     casadi_int max_iter_;
 
+    /// Handles of the residual and Jacobian functions
+    casadi_int ind_g_, ind_jac_f_z_;
+
     /// Absolute tolerance that should be met on residual
     double abstol_;
 
@@ -142,6 +155,15 @@ namespace casadi {
 
     bool line_search_;
 
+    /// Reuse the factorized Jacobian while the residual contracts sufficiently
+    bool jacobian_reuse_;
+
+    /// Maximum ratio of successive residual norms before the Jacobian is refreshed
+    double contraction_tol_;
+
+    /// Maximum number of Broyden updates between refactorizations
+    casadi_int max_broyden_;
+
     /// Print iteration header
     void printIteration(std::ostream &stream) const;
 
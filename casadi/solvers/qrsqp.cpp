@@ -179,14 +179,18 @@ namespace casadi {
 
     // Get/generate required functions
     create_function("nlp_fg", {"x", "p"}, {"f", "g"});
+    ind_fg_ = function_index("nlp_fg");
     // First order derivative information
     Function jac_g_fcn = create_function("nlp_jac_fg", {"x", "p"},
                                         {"f", "grad:f:x", "g", "jac:g:x"});
+    ind_jac_fg_ = function_index("nlp_jac_fg");
     Asp_ = jac_g_fcn.sparsity_out(3);
 
+    ind_hess_l_ = -1;
     if (exact_hessian_) {
       Function hess_l_fcn = create_function("nlp_hess_l", {"x", "p", "lam:f", "lam:g"},
                                            {"sym:hess:gamma:x:x"}, {{"gamma", {"f", "g"}}});
+      ind_hess_l_ = function_index("nlp_hess_l");
       Hsp_ = hess_l_fcn.sparsity_out(0);
     } else {
       Hsp_ = Sparsity::dense(nx_, nx_);
@@ -318,7 +322,7 @@ namespace casadi {
       m->res[1] = m->gf;
       m->res[2] = d_nlp->z + nx_;
       m->res[3] = m->Jk;
-      if (calc_function(m, "nlp_jac_fg")) return 1;
+      if (calc_function(m, ind_jac_fg_)) return 1;
 
       // Evaluate the gradient of the Lagrangian
       casadi_copy(m->gf, nx_, m->gLag);
@@ -377,7 +381,7 @@ namespace casadi {
         m->arg[2] = &one;
         m->arg[3] = d_nlp->lam + nx_;
         m->res[0] = m->Bk;
-        if (calc_function(m, "nlp_hess_l")) return 1;
+        if (calc_function(m, ind_hess_l_)) return 1;
 
         // Determing regularization parameter with Gershgorin theorem
         if (regularize_) {
@@ -468,7 +472,7 @@ namespace casadi {
           m->arg[1] = d_nlp->p;
           m->res[0] = &fk_cand;
           m->res[1] = m->z_cand + nx_;
-          if (calc_function(m, "nlp_fg")) {
+          if (calc_function(m, ind_fg_)) {
             // line-search failed, skip iteration
             t = beta_ * t;
             continue;
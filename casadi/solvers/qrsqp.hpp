@@ -128,6 +128,9 @@ namespace casadi {
     /// Exact Hessian?
     bool exact_hessian_;
 
+    /// Handles of the oracle functions
+    casadi_int ind_fg_, ind_jac_fg_, ind_hess_l_;
+
     /// Maximum, minimum number of SQP iterations
     casadi_int max_iter_, min_iter_;
 
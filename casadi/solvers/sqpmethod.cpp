@@ -33,6 +33,14 @@
 #include <ctime>
 #include <iomanip>
 #include <fstream>
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
 #include <cmath>
 #include <cfloat>
 
@@ -132,7 +140,19 @@ namespace casadi {
         "the smallest eigenvalue is at least this (default: 1e-7)."}},
       {"max_iter_eig",
        {OT_DOUBLE,
-        "Maximum number of iterations to compute an eigenvalue decomposition (default: 50)."}}
+        "Maximum number of iterations to compute an eigenvalue decomposition (default: 50)."}},
+      {"rti",
+       {OT_BOOL,
+        "Real-time iteration mode. Each call takes a single full SQP step: "
+        "a feedback phase solves one QP, linearized before the call, for the current "
+        "parameters and bounds; a preparation phase then linearizes at the new iterate "
+        "for the next call. The first call of a memory linearizes at x0, later calls "
+        "continue from the prepared iterate and ignore x0, lam_x0 and lam_g0. "
+        "The iteration callback is invoked between the two phases."}},
+      {"parallel_oracle",
+       {OT_BOOL,
+        "Evaluate the constraint Jacobian (nlp_jac_fg) and the Hessian of the Lagrangian "
+        "(nlp_hess_l) concurrently in separate threads. Requires WITH_THREAD=ON."}}
      }
   };
 
@@ -157,6 +177,8 @@ namespace casadi {
     print_header_ = true;
     print_iteration_ = true;
     print_status_ = true;
+    rti_ = false;
+    parallel_oracle_ = false;
 
     std::string convexify_strategy = "none";
     double convexify_margin = 1e-7;
@@ -212,6 +234,10 @@ namespace casadi {
         convexify_margin = op.second;
       } else if (op.first=="max_iter_eig") {
         max_iter_eig = op.second;
+      } else if (op.first=="rti") {
+        rti_ = op.second;
+      } else if (op.first=="parallel_oracle") {
+        parallel_oracle_ = op.second;
       }
     }
 
@@ -221,7 +247,7 @@ namespace casadi {
     convexify_ = false;
 
     // Get/generate required functions
-    if (max_iter_ls_) create_function("nlp_fg", {"x", "p"}, {"f", "g"});
+    if (max_iter_ls_ || rti_) create_function("nlp_fg", {"x", "p"}, {"f", "g"});
     // First order derivative information
 
     if (!has_function("nlp_jac_fg")) {
@@ -250,6 +276,22 @@ namespace casadi {
       Hsp_ = Sparsity::dense(nx_, nx_);
     }
 
+    if (parallel_oracle_) {
+#ifndef CASADI_WITH_THREAD
+      casadi_warning("CasADi was not compiled with WITH_THREAD=ON. "
+                     "Falling back to serial evaluation.");
+      parallel_oracle_ = false;
+#endif // CASADI_WITH_THREAD
+      // Nothing to run concurrently without an exact Hessian
+      if (!exact_hessian_) parallel_oracle_ = false;
+    }
+
+    // Handles for the callbacks
+    set_function_handles();
+
+    // Separate work vectors for the concurrent Hessian evaluation
+    if (parallel_oracle_) alloc(get_function("nlp_hess_l"), true);
+
     // Allocate a QP solver
     casadi_assert(!qpsol_plugin.empty(), "'qpsol' option has not been set");
     qpsol_ = conic("qpsol", qpsol_plugin, {{"h", Hsp_}, {"a", Asp_}},
@@ -308,6 +350,14 @@ namespace casadi {
     m->d.prob = &p_;
     casadi_sqpmethod_init(&m->d, &iw, &w);
 
+    if (parallel_oracle_) {
+      const Function& h = fcn_[ind_hess_l_]->second.f;
+      m->hess_mem.arg = arg; arg += h.sz_arg();
+      m->hess_mem.res = res; res += h.sz_res();
+      m->hess_mem.iw = iw; iw += h.sz_iw();
+      m->hess_mem.w = w; w += h.sz_w();
+    }
+
     m->iter_count = -1;
   }
 
@@ -319,6 +369,17 @@ namespace casadi {
     m->add_stat("BFGS");
     m->add_stat("QP");
     m->add_stat("linesearch");
+    m->hess_mem.fcn_stats = m->fcn_stats;
+    if (rti_) {
+      m->add_stat("rti_feedback");
+      m->add_stat("rti_preparation");
+      m->rti_prepared = false;
+      m->rti_z.resize(nx_);
+      m->rti_lam.resize(nx_+ng_);
+      m->rti_gf.resize(nx_);
+      m->rti_Jk.resize(Asp_.nnz());
+      m->rti_Bk.resize(Hsp_.nnz());
+    }
     return 0;
   }
 
@@ -327,6 +388,8 @@ int Sqpmethod::solve(void* mem) const {
     auto d_nlp = &m->d_nlp;
     auto d = &m->d;
 
+    if (rti_) return solve_rti(m);
+
     // Number of SQP iterations
     m->iter_count = 0;
 
@@ -344,21 +407,14 @@ int Sqpmethod::solve(void* mem) const {
     // Default stepsize
     double t = 0;
 
-    // For seeds
-    const double one = 1.;
-
     casadi_clear(d->dx, nx_);
 
     // MAIN OPTIMIZATION LOOP
     while (true) {
       // Evaluate f, g and first order derivative information
-      m->arg[0] = d_nlp->z;
-      m->arg[1] = d_nlp->p;
-      m->res[0] = &d_nlp->f;
-      m->res[1] = d->gf;
-      m->res[2] = d_nlp->z + nx_;
-      m->res[3] = d->Jk;
-      switch (calc_function(m, "nlp_jac_fg")) {
+      bool hess_done;
+      int hess_flag;
+      switch (calc_derivatives(m, hess_done, hess_flag)) {
         case -1:
           m->return_status = "Non_Regular_Sensitivities";
           m->unified_return_status = SOLVER_RET_NAN;
@@ -423,12 +479,7 @@ int Sqpmethod::solve(void* mem) const {
 
       if (exact_hessian_) {
         // Update/reset exact Hessian
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->arg[2] = &one;
-        m->arg[3] = d_nlp->lam + nx_;
-        m->res[0] = d->Bk;
-        if (calc_function(m, "nlp_hess_l")) return 1;
+        if (hess_done ? hess_flag : calc_hess_l(m, m)) return 1;
         if (convexify_) {
           ScopedTiming tic(m->fstats.at("convexify"));
           if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
@@ -513,7 +564,7 @@ int Sqpmethod::solve(void* mem) const {
           m->arg[1] = d_nlp->p;
           m->res[0] = &fk_cand;
           m->res[1] = d->z_cand + nx_;
-          if (calc_function(m, "nlp_fg")) {
+          if (calc_function(m, ind_fg_)) {
             // Avoid infinite recursion
             if (ls_iter == max_iter_ls_) {
               ls_success = false;
@@ -565,6 +616,194 @@ int Sqpmethod::solve(void* mem) const {
     return 0;
   }
 
+  int Sqpmethod::calc_hess_l(SqpmethodMemory* m, OracleMemory* mem) const {
+    auto d_nlp = &m->d_nlp;
+    const double one = 1.;
+    mem->arg[0] = d_nlp->z;
+    mem->arg[1] = d_nlp->p;
+    mem->arg[2] = &one;
+    mem->arg[3] = d_nlp->lam + nx_;
+    mem->res[0] = m->d.Bk;
+    return calc_function(mem, ind_hess_l_);
+  }
+
+  int Sqpmethod::calc_derivatives(SqpmethodMemory* m, bool& hess_done, int& hess_flag) const {
+    auto d_nlp = &m->d_nlp;
+    auto d = &m->d;
+    hess_done = false;
+    hess_flag = 0;
+
+#ifdef CASADI_WITH_THREAD
+    // Hessian of the Lagrangian in a separate thread, it only reads x, p and lam
+    std::thread hess_thread;
+    if (parallel_oracle_) {
+      hess_done = true;
+      hess_thread = std::thread([this, m, &hess_flag]() {
+        try {
+          hess_flag = calc_hess_l(m, &m->hess_mem);
+        } catch (std::exception& e) {
+          hess_flag = 1;
+          casadi_warning("Exception raised: " + std::string(e.what()));
+        } catch (...) {
+          hess_flag = 1;
+          casadi_warning("Uncaught exception.");
+        }
+      });
+    }
+#endif // CASADI_WITH_THREAD
+
+    m->arg[0] = d_nlp->z;
+    m->arg[1] = d_nlp->p;
+    m->res[0] = &d_nlp->f;
+    m->res[1] = d->gf;
+    m->res[2] = d_nlp->z + nx_;
+    m->res[3] = d->Jk;
+    int flag;
+#ifdef CASADI_WITH_THREAD
+    try {
+      flag = calc_function(m, ind_jac_fg_);
+    } catch (...) {
+      if (hess_thread.joinable()) hess_thread.join();
+      throw;
+    }
+    if (hess_thread.joinable()) hess_thread.join();
+#else // CASADI_WITH_THREAD
+    flag = calc_function(m, ind_jac_fg_);
+#endif // CASADI_WITH_THREAD
+    return flag;
+  }
+
+  int Sqpmethod::solve_rti(SqpmethodMemory* m) const {
+    auto d_nlp = &m->d_nlp;
+    auto d = &m->d;
+    m->iter_count = 0;
+
+    if (m->rti_prepared) {
+      // Continue from the prepared linearization
+      casadi_copy(get_ptr(m->rti_z), nx_, d_nlp->z);
+      casadi_copy(get_ptr(m->rti_lam), nx_+ng_, d_nlp->lam);
+      casadi_copy(get_ptr(m->rti_gf), nx_, d->gf);
+      casadi_copy(get_ptr(m->rti_Jk), Asp_.nnz(), d->Jk);
+      casadi_copy(get_ptr(m->rti_Bk), Hsp_.nnz(), d->Bk);
+    } else {
+      // Linearize at the initial guess
+      casadi_clear(d->dx, nx_);
+      if (rti_prepare(m)) return 1;
+    }
+
+    // Feedback phase
+    {
+      ScopedTiming tic(m->fstats.at("rti_feedback"));
+
+      // Objective and constraints for the current parameter values
+      m->arg[0] = d_nlp->z;
+      m->arg[1] = d_nlp->p;
+      m->res[0] = &d_nlp->f;
+      m->res[1] = d_nlp->z + nx_;
+      if (calc_function(m, ind_fg_)) {
+        m->return_status = "Non_Regular_Sensitivities";
+        m->unified_return_status = SOLVER_RET_NAN;
+        m->rti_prepared = false;
+        return 1;
+      }
+
+      // Formulate the QP
+      casadi_copy(d_nlp->lbz, nx_+ng_, d->lbdz);
+      casadi_axpy(nx_+ng_, -1., d_nlp->z, d->lbdz);
+      casadi_copy(d_nlp->ubz, nx_+ng_, d->ubdz);
+      casadi_axpy(nx_+ng_, -1., d_nlp->z, d->ubdz);
+
+      // Initial guess
+      casadi_copy(d_nlp->lam, nx_+ng_, d->dlam);
+      casadi_clear(d->dx, nx_);
+
+      // Solve the QP and take a full step
+      solve_QP(m, d->Bk, d->gf, d->lbdz, d->ubdz, d->Jk, d->dx, d->dlam);
+      casadi_copy(d->dlam, nx_ + ng_, d_nlp->lam);
+      casadi_axpy(nx_, 1., d->dx, d_nlp->z);
+      m->iter_count = 1;
+
+      if (!exact_hessian_) {
+        // Gradient of the Lagrangian with the old x but new lam (for BFGS)
+        casadi_copy(d->gf, nx_, d->gLag_old);
+        casadi_mv(d->Jk, Asp_, d_nlp->lam+nx_, d->gLag_old, true);
+        casadi_axpy(nx_, 1., d_nlp->lam, d->gLag_old);
+      }
+    }
+    m->return_status = "Solve_Succeeded";
+    m->success = true;
+
+    // The step is available to the callback before the preparation phase
+    if (callback(m)) {
+      if (print_status_) print("WARNING(sqpmethod): Aborted by callback...\n");
+      m->return_status = "User_Requested_Stop";
+      m->rti_prepared = false;
+      return 0;
+    }
+
+    // Preparation phase
+    if (rti_prepare(m)) {
+      m->success = false;
+      return 1;
+    }
+
+    if (print_iteration_) {
+      print_iteration();
+      print_iteration(m->iter_count, d_nlp->f,
+                      casadi_max_viol(nx_+ng_, d_nlp->z, d_nlp->lbz, d_nlp->ubz),
+                      casadi_norm_inf(nx_, d->gLag), casadi_norm_inf(nx_, d->dx),
+                      m->reg, 0, true);
+    }
+    return 0;
+  }
+
+  int Sqpmethod::rti_prepare(SqpmethodMemory* m) const {
+    ScopedTiming tic(m->fstats.at("rti_preparation"));
+    auto d_nlp = &m->d_nlp;
+    auto d = &m->d;
+    m->rti_prepared = false;
+
+    // Evaluate f, g and first order derivative information
+    bool hess_done;
+    int hess_flag;
+    if (calc_derivatives(m, hess_done, hess_flag)) {
+      m->return_status = "Non_Regular_Sensitivities";
+      m->unified_return_status = SOLVER_RET_NAN;
+      return 1;
+    }
+
+    // Gradient of the Lagrangian
+    casadi_copy(d->gf, nx_, d->gLag);
+    casadi_mv(d->Jk, Asp_, d_nlp->lam+nx_, d->gLag, true);
+    casadi_axpy(nx_, 1., d_nlp->lam, d->gLag);
+
+    if (exact_hessian_) {
+      if (hess_done ? hess_flag : calc_hess_l(m, m)) return 1;
+      if (convexify_) {
+        ScopedTiming tic(m->fstats.at("convexify"));
+        if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
+      }
+    } else if (m->iter_count==0) {
+      ScopedTiming tic(m->fstats.at("BFGS"));
+      // Initialize BFGS
+      casadi_fill(d->Bk, Hsp_.nnz(), 1.);
+      casadi_bfgs_reset(Hsp_, d->Bk);
+    } else if (casadi_norm_inf(nx_, d->dx) > min_step_size_) {
+      // Update BFGS, unless the step is too small for a well-defined update
+      ScopedTiming tic(m->fstats.at("BFGS"));
+      casadi_bfgs(Hsp_, d->Bk, d->dx, d->gLag, d->gLag_old, m->w);
+    }
+
+    // Keep the linearization for the next call
+    casadi_copy(d_nlp->z, nx_, get_ptr(m->rti_z));
+    casadi_copy(d_nlp->lam, nx_+ng_, get_ptr(m->rti_lam));
+    casadi_copy(d->gf, nx_, get_ptr(m->rti_gf));
+    casadi_copy(d->Jk, Asp_.nnz(), get_ptr(m->rti_Jk));
+    casadi_copy(d->Bk, Hsp_.nnz(), get_ptr(m->rti_Bk));
+    m->rti_prepared = true;
+    return 0;
+  }
+
   void Sqpmethod::print_iteration() const {
     print("%4s %14s %9s %9s %9s %7s %2s\n", "iter", "objective", "inf_pr",
           "inf_du", "||d||", "lg(rg)", "ls");
@@ -623,6 +862,7 @@ void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
   }
 
   void Sqpmethod::codegen_body(CodeGenerator& g) const {
+    casadi_assert(!rti_, "Code generation is not supported for option 'rti'");
     g.add_auxiliary(CodeGenerator::AUX_SQPMETHOD);
     nlpsol_codegen_body(g);
     // From nlpsol
@@ -866,7 +1106,7 @@ void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
   }
 
   Sqpmethod::Sqpmethod(DeserializingStream& s) : Nlpsol(s) {
-    int version = s.version("Sqpmethod", 1, 2);
+    int version = s.version("Sqpmethod", 1, 4);
     s.unpack("Sqpmethod::qpsol", qpsol_);
     s.unpack("Sqpmethod::exact_hessian", exact_hessian_);
     s.unpack("Sqpmethod::max_iter", max_iter_);
@@ -915,12 +1155,29 @@ void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
       s.unpack("Sqpmethod::convexify", convexify_);
       if (convexify_) Convexify::deserialize(s, "Sqpmethod::", convexify_data_);
     }
+    if (version>=3) {
+      s.unpack("Sqpmethod::rti", rti_);
+    } else {
+      rti_ = false;
+    }
+    if (version>=4) {
+      s.unpack("Sqpmethod::parallel_oracle", parallel_oracle_);
+    } else {
+      parallel_oracle_ = false;
+    }
+    set_function_handles();
     set_sqpmethod_prob();
   }
 
+  void Sqpmethod::set_function_handles() {
+    ind_fg_ = has_function("nlp_fg") ? function_index("nlp_fg") : -1;
+    ind_jac_fg_ = function_index("nlp_jac_fg");
+    ind_hess_l_ = has_function("nlp_hess_l") ? function_index("nlp_hess_l") : -1;
+  }
+
   void Sqpmethod::serialize_body(SerializingStream &s) const {
     Nlpsol::serialize_body(s);
-    s.version("Sqpmethod", 2);
+    s.version("Sqpmethod", 4);
     s.pack("Sqpmethod::qpsol", qpsol_);
     s.pack("Sqpmethod::exact_hessian", exact_hessian_);
     s.pack("Sqpmethod::max_iter", max_iter_);
@@ -941,5 +1198,7 @@ void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
     s.pack("Sqpmethod::Asp", Asp_);
     s.pack("Sqpmethod::convexify", convexify_);
     if (convexify_) Convexify::serialize(s, "Sqpmethod::", convexify_data_);
+    s.pack("Sqpmethod::rti", rti_);
+    s.pack("Sqpmethod::parallel_oracle", parallel_oracle_);
   }
 } // namespace casadi
@@ -53,6 +53,13 @@ namespace casadi {
 
     /// Iteration count
     int iter_count;
+
+    /// Work vectors for evaluating nlp_hess_l concurrently with nlp_jac_fg
+    OracleMemory hess_mem;
+
+    /// Real-time iterations: linearization prepared for the next feedback phase
+    bool rti_prepared;
+    std::vector<double> rti_z, rti_lam, rti_gf, rti_Jk, rti_Bk;
   };
 
   /** \brief  \pluginbrief{Nlpsol,sqpmethod}
@@ -103,6 +110,18 @@ namespace casadi {
     // Solve the NLP
     int solve(void* mem) const override;
 
+    /// Evaluate nlp_jac_fg at the current iterate, with nlp_hess_l concurrently if enabled
+    int calc_derivatives(SqpmethodMemory* m, bool& hess_done, int& hess_flag) const;
+
+    /// Evaluate nlp_hess_l at the current iterate, using the work vectors of mem
+    int calc_hess_l(SqpmethodMemory* m, OracleMemory* mem) const;
+
+    /// Real-time iteration: feedback phase followed by the preparation phase
+    int solve_rti(SqpmethodMemory* m) const;
+
+    /// Real-time iteration: linearize at the current iterate for the next feedback phase
+    int rti_prepare(SqpmethodMemory* m) const;
+
     // Memory structure
     casadi_sqpmethod_prob<double> p_;
 
@@ -138,6 +157,18 @@ namespace casadi {
     // Print options
     bool print_header_, print_iteration_, print_status_;
 
+    /// Real-time iteration mode
+    bool rti_;
+
+    /// Evaluate nlp_jac_fg and nlp_hess_l concurrently
+    bool parallel_oracle_;
+
+    /// Handles of the oracle functions
+    casadi_int ind_fg_, ind_jac_fg_, ind_hess_l_;
+
+    /// Look up the handles of the oracle functions
+    void set_function_handles();
+
     // Hessian Sparsity
     Sparsity Hsp_;
 
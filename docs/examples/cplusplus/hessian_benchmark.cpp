@@ -0,0 +1,78 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include <casadi/casadi.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace casadi;
+/**
+ * Sparse Hessians of partially separable objectives, as a symmetric Jacobian of the
+ * gradient (star coloring) and by edge pushing
+ */
+
+double toc(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+int main(int argc, char* argv[]) {
+  casadi_int n = argc>1 ? atoi(argv[1]) : 2000;
+  casadi_int m = argc>2 ? atoi(argv[2]) : 3*n;
+
+  // Sum of element functions, each coupling three pseudo-random variables
+  SX x = SX::sym("x", n);
+  SX f = 0;
+  unsigned int s = 1;
+  auto next = [&s, n]() { s = s*1103515245 + 12345; return (s/65536) % n;};
+  for (casadi_int k=0; k<m; ++k) {
+    casadi_int i = next(), j = next(), l = next();
+    f += sin(x(i)*x(j)) + pow(x(j) - exp(0.1*x(l)), 2) + x(i)/(1 + x(l)*x(l));
+  }
+  DM x0 = DM::rand(n, 1);
+
+  DM H_ref;
+  for (bool edge_pushing : {false, true}) {
+    auto t0 = std::chrono::steady_clock::now();
+    SX H = hessian(f, x, {{"edge_pushing", edge_pushing}});
+    double t_build = toc(t0);
+    t0 = std::chrono::steady_clock::now();
+    Function F("H", {x}, {H});
+    double t_fun = toc(t0);
+    t0 = std::chrono::steady_clock::now();
+    DM H0 = F(x0).at(0);
+    double t_eval = toc(t0);
+    double err = 0;
+    if (edge_pushing) {
+      err = static_cast<double>(norm_inf(H0 - H_ref));
+    } else {
+      H_ref = H0;
+    }
+    std::cout << (edge_pushing ? "edge pushing " : "star coloring")
+              << " nnz " << H.nnz() << " build " << t_build << " s, function " << t_fun
+              << " s, nodes " << F.n_nodes() << ", eval " << t_eval << " s, diff " << err
+              << std::endl;
+  }
+  return 0;
+}
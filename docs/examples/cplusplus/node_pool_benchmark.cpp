@@ -0,0 +1,89 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include <casadi/casadi.hpp>
+#include <casadi/core/node_pool.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace casadi;
+/**
+ * Time to build and destroy large SX and MX expression graphs,
+ * and the memory held by the node pool before and after teardown
+ */
+
+double toc(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+void print_pool(const std::string& when) {
+#ifdef CASADI_WITH_NODE_POOL
+  Dict st = NodePool::stats();
+  std::cout << "  node pool " << when << ": " << st.at("n_live") << " nodes, "
+            << st.at("bytes").to_int()/(1<<20) << " MiB" << std::endl;
+#endif // CASADI_WITH_NODE_POOL
+}
+
+int main() {
+  casadi_int n_rep = 3;
+  for (casadi_int rep=0; rep<n_rep; ++rep) {
+    std::cout << "Repetition " << rep << std::endl;
+
+    // SX graph with about 10^6 nodes
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<SX> sx_keep;
+    {
+      SX x = SX::sym("x", 10), y = SX::sym("y", 10), e = x;
+      for (casadi_int i=0; i<30000; ++i) {
+        e = sin(e)*y + e/(i+2.5);
+        if (i%100==0) sx_keep.push_back(e);
+      }
+      sx_keep.push_back(e);
+    }
+    std::cout << "  SX build:    " << toc(t0) << " s" << std::endl;
+    print_pool("with SX graph");
+    t0 = std::chrono::steady_clock::now();
+    sx_keep.clear();
+    std::cout << "  SX teardown: " << toc(t0) << " s" << std::endl;
+
+    // MX graph with about 3*10^5 nodes
+    t0 = std::chrono::steady_clock::now();
+    std::vector<MX> mx_keep;
+    {
+      MX x = MX::sym("x", 3), y = MX::sym("y", 3), e = x;
+      for (casadi_int i=0; i<100000; ++i) {
+        e = sin(e)*y + e;
+        if (i%100==0) mx_keep.push_back(e);
+      }
+      mx_keep.push_back(e);
+    }
+    std::cout << "  MX build:    " << toc(t0) << " s" << std::endl;
+    t0 = std::chrono::steady_clock::now();
+    mx_keep.clear();
+    std::cout << "  MX teardown: " << toc(t0) << " s" << std::endl;
+    print_pool("after teardown");
+  }
+  return 0;
+}
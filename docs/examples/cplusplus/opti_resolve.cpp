@@ -0,0 +1,91 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include <casadi/casadi.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace casadi;
+/**
+ * Latency of repeated parametric solves with Opti, as in a control loop:
+ * 'solve' after 'set_value' versus the preallocated, warm-started 'resolve'
+ */
+
+// Pendulum swing-down over a horizon of N steps, initial state as parameter
+Opti pendulum(MX& x0, casadi_int N) {
+  Opti opti;
+  MX X = opti.variable(2, N+1);
+  MX U = opti.variable(1, N);
+  x0 = opti.parameter(2);
+  opti.subject_to(X(Slice(), 0) == x0);
+  MX J = 0;
+  for (casadi_int k=0; k<N; ++k) {
+    MX xk = X(Slice(), k);
+    MX rhs = vertcat(xk(1), -sin(xk(0)) + U(k));
+    opti.subject_to(X(Slice(), k+1) == xk + 0.1*rhs);
+    opti.subject_to(-1 <= U(k) <= 1);
+    J += sumsqr(xk) + sumsqr(U(k));
+  }
+  opti.minimize(J);
+  Dict qpsol_options = {{"print_iter", false}, {"print_header", false}};
+  opti.solver("sqpmethod", {{"qpsol", "qrqp"}, {"qpsol_options", qpsol_options},
+                            {"print_header", false}, {"print_iteration", false},
+                            {"print_status", false}, {"print_time", false}});
+  return opti;
+}
+
+int main() {
+  casadi_int n_run = 100;
+  MX x0;
+  Opti opti = pendulum(x0, 20);
+  std::vector<double> p(2), x(opti.debug().nx());
+
+  // Regular solve
+  double t_solve = 0;
+  for (casadi_int k=0; k<=n_run; ++k) {
+    p[0] = 0.5*cos(0.1*k);
+    p[1] = 0.3*sin(0.1*k);
+    auto t0 = std::chrono::steady_clock::now();
+    opti.set_value(x0, p);
+    opti.solve();
+    auto t1 = std::chrono::steady_clock::now();
+    if (k>0) t_solve += std::chrono::duration<double>(t1-t0).count();
+  }
+
+  // Parametric re-solve, the first call sets up the buffers
+  double t_resolve = 0;
+  for (casadi_int k=0; k<=n_run; ++k) {
+    p[0] = 0.5*cos(0.1*k);
+    p[1] = 0.3*sin(0.1*k);
+    auto t0 = std::chrono::steady_clock::now();
+    opti.resolve(get_ptr(p), get_ptr(x));
+    auto t1 = std::chrono::steady_clock::now();
+    if (k>0) t_resolve += std::chrono::duration<double>(t1-t0).count();
+  }
+
+  std::cout << "solve:   " << 1e6*t_solve/n_run << " us per call" << std::endl;
+  std::cout << "resolve: " << 1e6*t_resolve/n_run << " us per call" << std::endl;
+  return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+#include <casadi/casadi.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+using namespace casadi;
+/**
+ * Evaluation of a large expanded model from its algorithm in memory and
+ * streamed from a packed tape file
+ */
+
+double toc(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+int main(int argc, char* argv[]) {
+  casadi_int n = argc>1 ? atoi(argv[1]) : 1000000;
+  std::string fname = argc>2 ? argv[2] : "packed_tape_benchmark.tape";
+
+  // Long recurrence on a small state
+  std::vector<double> x0(10, 0.5), r_ref(10), r(10);
+  {
+    SX x = SX::sym("x", 10);
+    std::vector<SX> v = vertsplit(x);
+    for (casadi_int i=0; i<n; ++i) {
+      v[i%10] = sin(v[i%10])*v[(i+3)%10] + 0.1*v[(i+7)%10];
+    }
+    Function f("f", {x}, {vertcat(v)});
+    auto t0 = std::chrono::steady_clock::now();
+    f({&x0[0]}, {&r_ref[0]});
+    // Each instruction of the algorithm takes 16 bytes
+    std::cout << "in memory: " << f.n_instructions() << " instructions, "
+              << 16*f.n_instructions() << " bytes, eval "
+              << toc(t0) << " s" << std::endl;
+    t0 = std::chrono::steady_clock::now();
+    f.save_tape(fname);
+    std::cout << "save_tape " << toc(t0) << " s" << std::endl;
+  }
+
+  // The expression graph has been freed, only the file is needed
+  Function g = Function::load_tape("g", fname);
+  std::ifstream file(fname, std::ios::binary | std::ios::ate);
+  auto t0 = std::chrono::steady_clock::now();
+  g({&x0[0]}, {&r[0]});
+  double t_eval = toc(t0);
+  double err = 0;
+  for (casadi_int i=0; i<10; ++i) err = std::max(err, std::abs(r[i]-r_ref[i]));
+  std::cout << "packed tape: " << file.tellg() << " bytes, eval " << t_eval
+            << " s, diff " << err << std::endl;
+  return 0;
+}
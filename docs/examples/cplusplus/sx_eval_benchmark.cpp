@@ -0,0 +1,97 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2014 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            K.U. Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+#include <casadi/casadi.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace casadi;
+/**
+ * Throughput of the SX virtual machine: numerical evaluation and forward and
+ * reverse sparsity propagation, with and without the compact tape
+ */
+
+double toc(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+}
+
+int main(int argc, char* argv[]) {
+  casadi_int n = argc>1 ? atoi(argv[1]) : 1000;
+  casadi_int m = argc>2 ? atoi(argv[2]) : 1000*n;
+  casadi_int n_rep = argc>3 ? atoi(argv[3]) : 10;
+
+  // Cheap element functions of pseudo-random variables, summed into n outputs,
+  // so that the loops are limited by memory traffic rather than arithmetic
+  SX x = SX::sym("x", n);
+  std::vector<SX> r(n, 0);
+  unsigned int s = 1;
+  auto next = [&s, n]() { s = s*1103515245 + 12345; return (s/65536) % n;};
+  for (casadi_int k=0; k<m; ++k) {
+    casadi_int i = next(), j = next(), l = next();
+    r[k % n] += x(i)*x(j) - 0.5*x(l) + x(i)*x(l);
+  }
+  SX y = vertcat(r);
+
+  // Configurations to compare
+  std::vector<std::pair<std::string, Dict>> config = {
+    {"standard", {{"compact_tape", false}}},
+    {"compact ", {}}};
+  std::vector<Function> f;
+  for (auto&& c : config) f.push_back(Function("f", {x}, {y}, c.second));
+
+  std::vector<double> x0(n), y0(n);
+  for (casadi_int i=0; i<n; ++i) x0[i] = 0.01*i;
+  std::vector<bvec_t> bx(n, 1), by(n);
+  const double* arg = &x0[0];
+  double* res = &y0[0];
+  const bvec_t* barg = &bx[0];
+  bvec_t* barg_rev = &bx[0];
+  bvec_t* bres = &by[0];
+
+  // Best of n_rep, alternating between the configurations
+  std::vector<double> t_eval(f.size(), inf), t_fwd(f.size(), inf), t_rev(f.size(), inf);
+  for (casadi_int k=0; k<n_rep; ++k) {
+    for (casadi_int i=0; i<f.size(); ++i) {
+      std::vector<casadi_int> iw(f[i].sz_iw());
+      std::vector<double> w(f[i].sz_w());
+      std::vector<bvec_t> bw(f[i].sz_w());
+      auto t0 = std::chrono::steady_clock::now();
+      f[i](&arg, &res, &iw[0], &w[0]);
+      t_eval[i] = std::min(t_eval[i], toc(t0));
+      t0 = std::chrono::steady_clock::now();
+      f[i](&barg, &bres, &iw[0], &bw[0]);
+      t_fwd[i] = std::min(t_fwd[i], toc(t0));
+      std::fill(by.begin(), by.end(), 1);
+      t0 = std::chrono::steady_clock::now();
+      f[i].rev(&barg_rev, &bres, &iw[0], &bw[0]);
+      t_rev[i] = std::min(t_rev[i], toc(t0));
+    }
+  }
+  for (casadi_int i=0; i<f.size(); ++i) {
+    std::cout << config[i].first << " instructions " << f[i].n_instructions()
+              << ", work vector " << f[i].sz_w() << ", eval " << t_eval[i]
+              << " s, sp_forward " << t_fwd[i] << " s, sp_reverse " << t_rev[i]
+              << " s" << std::endl;
+  }
+  return 0;
+}
@@ -4277,6 +4277,7 @@ namespace casadi {
 %include <casadi/core/importer.hpp>
 %include <casadi/core/callback.hpp>
 %include <casadi/core/global_options.hpp>
+%include <casadi/core/profiler.hpp>
 %include <casadi/core/casadi_meta.hpp>
 %include <casadi/core/integration_tools.hpp>
 %include <casadi/core/nlp_tools.hpp>
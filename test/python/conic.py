@@ -81,6 +81,9 @@ if has_conic("cbc"):
 if has_conic("qrqp"):
   conics.append(("qrqp",{"max_iter":20,"print_header":False,"print_iter":False},{"quadratic": True, "dual": True, "soc": False, "codegen": True, "discrete": False, "sos":False}))
 
+if has_conic("ipqp"):
+  conics.append(("ipqp",{"print_header":False,"print_iter":False},{"less_digits":2,"quadratic": True, "dual": True, "soc": False, "codegen": True, "discrete": False, "sos":False}))
+
 
 print(conics)
 
@@ -1125,6 +1128,91 @@ class ConicTests(casadiTestCase):
     self.checkarray(sol_ref["lam_a"], sol["lam_a"],digits=8)
     self.checkarray(sol_ref["lam_x"], sol["lam_x"],digits=8)
 
+  def test_condensing(self):
+    # Multiple-shooting QP for a double integrator, x = [x0 u0 x1 u1 ... xN]
+    N = 6
+    Ad = DM([[1,0.1],[0,1]])
+    Bd = DM([0.005,0.1])
+    X = [MX.sym("x%d" % k,2) for k in range(N+1)]
+    U = [MX.sym("u%d" % k) for k in range(N)]
+    z = vertcat(*[vertcat(X[k],U[k]) for k in range(N)]+[X[N]])
+    f = 10*sumsqr(X[N])
+    g = []
+    for k in range(N):
+      f += sumsqr(X[k]) + 0.2*X[k][0]*X[k][1] + 0.1*U[k]**2 + 0.1*X[k][1]
+      g.append(2*X[k+1]-2*mtimes(Ad,X[k])-2*Bd*U[k])
+      g.append(X[k][0]+U[k])
+    g = vertcat(*g)
+    H, G = hessian(f,z)
+    A = jacobian(g,z)
+    F = Function("F",[z],[H,substitute(G,z,DM.zeros(z.shape)),A])
+    H, G, A = F(0)
+    H = sparsify(H)
+    A = sparsify(A)
+
+    lba = vertcat(*[vertcat(0,0.02,-inf) for k in range(N)])
+    uba = vertcat(*[vertcat(0,0.02,0.8) for k in range(N)])
+    lbx = vertcat(*[vertcat(-inf,-0.1 if k>0 else -inf,-2) for k in range(N)]+[-inf,-0.1])
+    ubx = vertcat(*[vertcat(inf,inf,2) for k in range(N)]+[inf,inf])
+    lbx[0] = ubx[0] = 1
+    lbx[1] = ubx[1] = 0.5
+
+    opts = {"print_iter":False,"print_header":False}
+    solver_ref = conic('solver', 'qrqp', {"a": A.sparsity(), "h": H.sparsity()},opts)
+    sol_ref = solver_ref(a=A,h=H,g=G,lba=lba,uba=uba,lbx=lbx,ubx=ubx)
+
+    for structure in [{}, {"N":N,"nx":[2]*(N+1),"nu":[1]*N,"ng":[1]*N+[0]}]:
+      options = {"qpsol":"qrqp","qpsol_options":opts}
+      options.update(structure)
+      solver = conic('solver', 'condensing', {"a": A.sparsity(), "h": H.sparsity()},options)
+      sol = solver(a=A,h=H,g=G,lba=lba,uba=uba,lbx=lbx,ubx=ubx)
+
+      self.checkarray(sol_ref["x"], sol["x"],digits=8)
+      self.checkarray(sol_ref["cost"], sol["cost"],digits=8)
+      self.checkarray(sol_ref["lam_a"], sol["lam_a"],digits=8)
+      self.checkarray(sol_ref["lam_x"], sol["lam_x"],digits=8)
+
+    # Gap-closing constraints must be equalities
+    solver = conic('solver', 'condensing', {"a": A.sparsity(), "h": H.sparsity()},{"qpsol_options":opts})
+    uba[0] = 1
+    with self.assertInException("must be an equality"):
+      solver(a=A,h=H,g=G,lba=lba,uba=uba,lbx=lbx,ubx=ubx)
+
+  @requires_conic("ipqp")
+  def test_ipqp(self):
+    # Sparse QP with active and inactive bounds and an equality constraint
+    H = sparsify(DM([[4,1,0,0],[1,2,0,0],[0,0,3,1],[0,0,1,1]]))
+    G = DM([1,-2,-1,0.5])
+    A = sparsify(DM([[1,1,0,0],[0,1,1,0],[1,0,0,-1],[0,0,1,1]]))
+    lba = DM([-inf,0.5,-1,1])
+    uba = DM([1,inf,1,1])
+    lbx = DM([-2,-inf,0,-inf])
+    ubx = DM([2,0.8,inf,0.3])
+
+    solver_in = {"h":H,"g":G,"a":A,"lba":lba,"uba":uba,"lbx":lbx,"ubx":ubx}
+    opts = {"print_header":False,"print_iter":False}
+    solver_ref = conic('solver', 'qrqp', {"a": A.sparsity(), "h": H.sparsity()},opts)
+    sol_ref = solver_ref(**solver_in)
+
+    solver = conic('solver', 'ipqp', {"a": A.sparsity(), "h": H.sparsity()},opts)
+    sol = solver(**solver_in)
+    self.assertTrue(solver.stats()["success"])
+
+    for k in ["x","cost","lam_a","lam_x"]:
+      self.checkarray(sol_ref[k], sol[k],digits=6)
+
+    # Fixed variable
+    solver_in["lbx"] = DM([-0.3,-inf,0,-inf])
+    solver_in["ubx"] = DM([-0.3,0.8,inf,0.3])
+    sol_ref = solver_ref(**solver_in)
+    sol = solver(**solver_in)
+    self.assertTrue(solver.stats()["success"])
+    for k in ["x","cost","lam_a","lam_x"]:
+      self.checkarray(sol_ref[k], sol[k],digits=6)
+
+    self.check_codegen(solver,solver_in,std="c99")
+    self.check_serialize(solver,solver_in)
+
 
   @requires_nlpsol("ipopt")
   def test_SOCP(self):
@@ -1114,6 +1114,29 @@ class Functiontests(casadiTestCase):
       self.assertTrue(same(F([-.6, 2.5]), 24.4))
       self.assertTrue(same(F([-.6, 3.5]), 34.4))
 
+  def test_interpolant_batch(self):
+    np.random.seed(0)
+    grid = [sorted(np.random.random(7)), sorted(np.random.random(5)), sorted(np.random.random(4))]
+    values = np.random.random(2*7*5*4)
+    N = 25
+    X = np.random.random((3,N))*1.4-0.2
+    X[:,10:] = np.sort(X[:,10:],axis=1)
+    for lookup_mode in ["linear","exact","binary"]:
+      opts = {"lookup_mode": [lookup_mode]*3}
+      F = interpolant('F', 'linear', grid, values, opts)
+      opts["batch_x"] = N
+      Fb = interpolant('Fb', 'linear', grid, values, opts)
+      ref = horzcat(*[F(X[:,k]) for k in range(N)])
+      self.checkarray(Fb(X),ref,digits=14)
+
+      x = MX.sym("x",3,N)
+      J = Function("J",[x],[jacobian(Fb(x),x)])
+      x = MX.sym("x",3)
+      J1 = Function("J1",[x],[jacobian(F(x),x)])
+      self.checkarray(J(X),diagcat(*[J1(X[:,k]) for k in range(N)]))
+      self.check_codegen(Fb,inputs=[X])
+      self.check_codegen(J,inputs=[X])
+
   @skip(not scipy_interpolate)
   def test_nd_linear(self):
 
@@ -2724,6 +2747,112 @@ class Functiontests(casadiTestCase):
     f2 = ff.get_function("f")
 
     self.checkfunction_light(g, f2, inputs=[3])
-          
+
+  def test_profiler(self):
+    x = MX.sym("x")
+    f = Function("f",[x],[sin(x)])
+    g = Function("g",[x],[f(x)*f(2*x)])
+    g = Function("h",[x],[g.call([x],True)[0]])
+    Profiler.reset()
+    self.assertFalse(Profiler.is_active())
+    for clock in ["cycles","steady"]:
+      Profiler.reset()
+      Profiler.start({"clock":clock,"sample":2})
+      for i in range(10): g(0.3)
+      Profiler.stop()
+      g(0.3)
+      st = Profiler.stats()
+      h = st["children"]["h"]
+      self.assertEqual(h["n_call"],10)
+      self.assertEqual(h["children"]["f"]["n_call"],20)
+      self.assertTrue(h["t_inclusive"]>=h["t_self"])
+      self.assertTrue(h["t_inclusive"]>=h["children"]["f"]["t_inclusive"])
+      self.assertAlmostEqual(st["t_inclusive"],h["t_inclusive"])
+      import json
+      Profiler.to_chrome_trace("profiler_trace.json")
+      with open("profiler_trace.json") as fh:
+        events = json.load(fh)["traceEvents"]
+      self.assertEqual(len(events),15)
+      Profiler.to_flamegraph("profiler_flame.json")
+      with open("profiler_flame.json") as fh:
+        self.assertEqual(json.load(fh)["children"][0]["name"],"h")
+    Profiler.reset()
+
+  def test_profile_instructions(self):
+    x = SX.sym("x",3)
+    fs = Function("fs",[x],[sin(x)*x+dot(x,x)],{"profile_instructions":True})
+    X = MX.sym("X",4,4)
+    fm = Function("fm",[X],[mtimes(X,X)[:2,:]+fs(X[:3,0])[0]],{"profile_instructions":True})
+    for f in [fm, fm.deserialize(fm.serialize())]:
+      self.checkarray(f(DM.ones(4,4)), mtimes(DM.ones(4,4),DM.ones(4,4))[:2,:]+fs(DM.ones(3))[0])
+      instr = f.stats()["instructions"]
+      self.assertEqual(instr["mtimes"]["n_call"],1)
+      self.assertEqual(instr["call:fs"]["n_call"],1)
+      self.assertTrue(instr["mtimes"]["t_wall"]>=0)
+    fs(DM.ones(3))
+    instr = fs.stats()["instructions"]
+    self.assertEqual(instr["sin"]["n_call"],3)
+    self.assertEqual(instr["output"]["n_call"],3)
+    self.assertFalse("instructions" in Function("f",[x],[sin(x)]).stats())
+
+    # Categories appear in all profiler outputs
+    import json
+    Profiler.reset()
+    Profiler.start()
+    fm(DM.ones(4,4))
+    Profiler.stop()
+    st = Profiler.stats()["children"]["fm"]["children"]
+    self.assertEqual(st["mtimes"]["n_call"],1)
+    self.assertEqual(st["fs"]["children"]["sin"]["n_call"],3)
+    self.assertFalse("call:fs" in st)
+    Profiler.to_chrome_trace("profiler_trace.json")
+    with open("profiler_trace.json") as fh:
+      events = {e["name"]: e for e in json.load(fh)["traceEvents"]}
+    self.assertEqual(events["sin"]["args"]["n_call"],3)
+    self.assertTrue(events["mtimes"]["ts"]>=events["fm"]["ts"])
+    self.assertFalse("args" in events["fm"])
+    Profiler.to_flamegraph("profiler_flame.json")
+    with open("profiler_flame.json") as fh:
+      fm_node = json.load(fh)["children"][0]
+    self.assertTrue("mtimes" in [c["name"] for c in fm_node["children"]])
+    Profiler.reset()
+
+  def test_jac_block(self):
+    for X in [SX, MX]:
+      x = X.sym("x",2)
+      y = X.sym("y")
+      p = X.sym("p",3)
+      f = Function("f",[x,y,p],[sin(x)*p[:2]+y,dot(p,p)*y],["x","y","p"],["r","s"])
+      J = f.jac()
+      Jb = f.jac_block(["s","r"],["p","x"])
+      self.assertEqual(Jb.name_out(),["DsDp","DsDx","DrDp","DrDx"])
+      self.assertEqual(Jb.name_in(),J.name_in())
+      inputs = [DM([0.3,0.7]),1.3,DM([0.2,1.1,-0.5]),0,0]
+      res = J.call(dict(zip(J.name_in(),inputs)))
+      resb = Jb.call(dict(zip(Jb.name_in(),inputs)))
+      for n in Jb.name_out():
+        self.checkarray(resb[n],res[n])
+      # Cached
+      self.assertEqual(hash(f.jac_block(["s","r"],["p","x"])),hash(Jb))
+      self.assertNotEqual(hash(f.jac_block(["s"],["p"])),hash(Jb))
+
+  def test_packed_tape(self):
+    x = SX.sym("x",3)
+    y = SX.sym("y",Sparsity.lower(2))
+    e = x
+    for i in range(200):
+      e = sin(e)*2.1+cos(e[::-1])*e-0.3
+    f = Function("f",[x,y],[dot(e,e),mtimes(y,e[:2]),3.5],["x","y"],["a","b","c"])
+    f.save_tape('f.tape')
+    g = Function.load_tape("g",'f.tape')
+    self.assertEqual(g.name_in(),f.name_in())
+    self.assertEqual(g.name_out(),f.name_out())
+    self.assertTrue(g.sparsity_in(1)==f.sparsity_in(1))
+    self.checkfunction_light(f,g,inputs=[DM([0.3,0.7,-0.2]),DM([[1.1,0],[0.3,-2]])])
+
+    z = SX.sym("z")
+    with self.assertInException("free"):
+      Function("h",[x],[x*z]).save_tape('h.tape')
+
 if __name__ == '__main__':
     unittest.main()
@@ -314,6 +314,26 @@ class ImplicitFunctiontests(casadiTestCase):
       res = solver(x0=0)["x"]
       self.checkarray(res,-1.7692923542386)
 
+  def test_jacobian_reuse(self):
+    z = SX.sym("z",3)
+    p = SX.sym("p")
+    g = vertcat(z[0]+0.1*sin(z[1])-p, z[1]+0.1*z[0]*z[2]-2*p, z[2]+0.05*z[0]**2-1)
+    ref = rootfinder("ref","newton",{"x":z,"p":p,"g":g})
+    for opts in [{"jacobian_reuse":True}, {"jacobian_reuse":True,"max_broyden":5}]:
+      solver = rootfinder("solver","newton",{"x":z,"p":p,"g":g},opts)
+      z0 = 0
+      for i, p0 in enumerate([1,1.01,1.02,1.05]):
+        z0 = solver(x0=z0,p=p0)["x"]
+        self.checkarray(z0,ref(x0=0,p=p0)["x"],digits=10)
+        stats = solver.stats()
+        self.assertTrue(stats["success"])
+        self.assertTrue(stats["n_fact"]<=stats["iter_count"])
+        # Factorization is kept between calls
+        if i>0: self.assertEqual(stats["n_fact"],0)
+        if "max_broyden" in opts:
+          self.assertTrue(stats["n_broyden"]>0)
+      self.check_serialize(solver,inputs=[0,1])
+
   def test_segfault_codegen(self):
     # Symbols
     x = MX.sym("x")
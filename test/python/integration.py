@@ -60,6 +60,8 @@ integrators.append(("collocation",["dae","ode"],{"rootfinder":"newton","number_o
 
 integrators.append(("rk",["ode"],{"number_of_finite_elements": 1000,"simplify":True}))
 
+integrators.append(("collocation",["dae","ode"],{"rootfinder":"newton","number_of_finite_elements": 18,"parareal_blocks":3}))
+
 
 print("Will test these integrators:")
 for cl, t, options in integrators:
@@ -1103,6 +1105,33 @@ class Integrationtests(casadiTestCase):
       # xf:0.259754<=0, zf:0.26948<=0
 
 
+  def test_parareal(self):
+    x = SX.sym("x",2)
+    t = SX.sym("t")
+    p = SX.sym("p")
+    dae = {'x':x, 't':t, 'p':p, 'ode':vertcat(x[1],-p*x[0]+sin(t)), 'quad':x[0]**2}
+
+    for plugin in ["rk","collocation"]:
+      for parallelization in ["serial","openmp","thread"]:
+        opts = {"tf":5,"number_of_finite_elements":40}
+        I_ref = integrator("I_ref",plugin,dae,opts)
+        opts["parareal_blocks"] = 8
+        opts["parallelization"] = parallelization
+        I = integrator("I",plugin,dae,opts)
+        sol_ref = I_ref(x0=vertcat(1,0),p=2)
+        sol = I(x0=vertcat(1,0),p=2)
+        self.checkarray(sol["xf"],sol_ref["xf"],digits=10)
+        self.checkarray(sol["qf"],sol_ref["qf"],digits=10)
+
+        # Forward sensitivities use the same scheme
+        x0 = MX.sym("x0",2)
+        J = Function("J",[x0],[jacobian(I(x0=x0,p=2)["xf"],x0)])
+        J_ref = Function("J",[x0],[jacobian(I_ref(x0=x0,p=2)["xf"],x0)])
+        self.checkarray(J(vertcat(1,0)),J_ref(vertcat(1,0)),digits=10)
+
+    with self.assertInException("must divide"):
+      integrator("I","rk",dae,{"number_of_finite_elements":10,"parareal_blocks":3})
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -78,12 +78,15 @@ except:
 try:
   load_linsol("qr")
   lsolvers.append(("qr",{},set()))
+  lsolvers.append(("qr",{"preordering":"nested_dissection","nd_leaf_size":1},set()))
 except:
   pass
 
 try:
   load_linsol("ldl")
   lsolvers.append(("ldl",{},{"posdef","symmetry"}))
+  lsolvers.append(("ldl",{"preordering":"nested_dissection","nd_leaf_size":1},{"posdef","symmetry"}))
+  lsolvers.append(("ldl",{"preordering":"none"},{"posdef","symmetry"}))
 except:
   pass
 
@@ -473,6 +476,40 @@ class LinearSolverTests(casadiTestCase):
       with self.assertRaises(Exception):
         solve(As,bs,Solver,options)
 
+  def test_krylov(self):
+    if not has_linsol("krylov"): return
+    numpy.random.seed(0)
+    n = 30
+    # Sparse symmetric positive definite and symmetric indefinite systems
+    T = DM(Sparsity.banded(n,2),numpy.random.random(Sparsity.banded(n,2).nnz()))
+    A_pd = T+T.T+10*DM.eye(n)
+    A_ind = T+T.T-2*DM.eye(n)
+    b = DM(numpy.random.random(n))
+    for A in [A_pd, A_ind]:
+      x_ref = solve(A, b, "qr")
+      for method in ["gmres","minres","cg"]:
+        if method=="cg" and A is A_ind: continue
+        for pc in ["none","jacobi","ildl"]:
+          opts = {"method":method,"preconditioner":pc,"tol":1e-12}
+          solver = Linsol("solver", "krylov", A.sparsity(), opts)
+          self.checkarray(solver.solve(A, b), x_ref, digits=8)
+          stats = solver.stats()
+          self.assertTrue(stats["success"])
+          self.assertTrue(stats["iter_count"]>0)
+
+    # Restarted GMRES on an unsymmetric system, transposed solve
+    A = T+10*DM.eye(n)
+    solver = Linsol("solver", "krylov", A.sparsity(), {"restart":5,"tol":1e-12})
+    self.checkarray(solver.solve(A, b), solve(A, b, "qr"), digits=8)
+    self.checkarray(solver.solve(A, b, True), solve(A.T, b, "qr"), digits=8)
+
+    # Matrix-free operator, the sparse matrix is only used for preconditioning
+    x = MX.sym("x",n)
+    op = Function("op",[x],[mtimes(A_pd,x)])
+    solver = Linsol("solver", "krylov", Sparsity.diag(n),
+      {"method":"cg","preconditioner":"jacobi","operator":op,"tol":1e-12})
+    self.checkarray(solver.solve(diag(diag(A_pd)), b), solve(A_pd, b, "qr"), digits=8)
+
   def test_cache(self):
     n = 5
 
@@ -1667,6 +1667,73 @@ class NLPtests(casadiTestCase):
       self.check_codegen(solver,{"x0":x0},std="c99")
 
 
+  def test_warm_start_cache(self):
+    x = SX.sym("x",2)
+    p = SX.sym("p")
+    nlp = {"x":x,"p":p,"f":(1-x[0])**2+100*(x[1]-x[0]**2)**2,"g":x[0]+x[1]-p}
+    options = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},"print_header":False,"print_iteration":False,"print_time":False}
+    ref = nlpsol("solver","sqpmethod",nlp,options)
+    options["warm_start_cache"] = 3
+    options["warm_start_cache_radius"] = 1
+    solver = nlpsol("solver","sqpmethod",nlp,options)
+
+    iter_ref = 0
+    iter = 0
+    for pv in [3,-2,3.1,-2.1,10]:
+      args = {"x0":DM([-1.5,1]),"p":pv,"lbg":0,"ubg":0}
+      res_ref = ref(**args)
+      res = solver(**args)
+      self.checkarray(res["x"],res_ref["x"],digits=7)
+      iter_ref += ref.stats()["iter_count"]
+      iter += solver.stats()["iter_count"]
+    stats = solver.stats()
+    self.assertEqual(stats["warm_start_hits"],2)
+    self.assertEqual(stats["warm_start_misses"],3)
+    self.assertTrue(iter<iter_ref)
+
+    self.check_serialize(solver,{"x0":DM([-1.5,1]),"p":3,"lbg":0,"ubg":0})
+
+  def test_sqpmethod_rti(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":(1-x[0])**2+(x[1]-x[0]**2)**2,"g":x[0]+x[1]-p}
+    options = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},"print_header":False,"print_iteration":False,"print_time":False}
+    for hessian_approximation in ["exact","limited-memory"]:
+      options["hessian_approximation"] = hessian_approximation
+      ref = nlpsol("solver","sqpmethod",nlp,options)
+      solver = nlpsol("solver","sqpmethod",nlp,dict(options,rti=True))
+      args = {"x0":DM([0.5,0.5]),"p":1.5,"lbg":0,"ubg":0}
+      x_ref = ref(**args)["x"]
+      # Each call takes a single step from the prepared iterate
+      for i in range(30):
+        res = solver(**args)
+        self.assertEqual(solver.stats()["iter_count"],1)
+      self.checkarray(res["x"],x_ref,digits=6)
+      stats = solver.stats()
+      self.assertTrue("t_wall_rti_feedback" in stats)
+      self.assertTrue("t_wall_rti_preparation" in stats)
+      # Tracks a changing parameter
+      args["p"] = 1.6
+      res = solver(**args)
+      self.checkarray(res["x"][0]+res["x"][1],1.6,digits=8)
+
+    with self.assertInException("rti"):
+      solver.generate("f.c")
+
+  def test_sqpmethod_parallel_oracle(self):
+    x = SX.sym("x",5)
+    f = sum([(1-x[i])**2+10*(x[i+1]-x[i]**2)**2 for i in range(4)])
+    nlp = {"x":x,"f":f,"g":vertcat(x[0]*x[1],x[2]+x[3]**2)}
+    options = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},"print_header":False,"print_iteration":False,"print_time":False}
+    ref = nlpsol("solver","sqpmethod",nlp,options)
+    solver = nlpsol("solver","sqpmethod",nlp,dict(options,parallel_oracle=True))
+    args = {"x0":DM.ones(5)*0.5,"lbg":-inf,"ubg":vertcat(0.5,2)}
+    res_ref = ref(**args)
+    res = solver(**args)
+    self.checkarray(res["x"],res_ref["x"],digits=10)
+    self.assertEqual(solver.stats()["iter_count"],ref.stats()["iter_count"])
+    self.check_serialize(solver,args)
+
   def test_simple_bounds_detect(self):
 
     x = SX.sym("x",5)
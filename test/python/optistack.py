@@ -987,5 +987,84 @@ class OptiStacktests(inherit_from):
       self.checkarray(res,DM([5-8/sqrt(5),7-4/sqrt(5)]),conic,digits=7)
       self.checkarray(sol.value(opti.f),10-16/sqrt(5)+7-4/sqrt(5),conic,digits=7)
 
+    def test_incremental_bake(self):
+      def reference(n):
+        opti = Opti()
+        x = opti.variable(2)
+        u = opti.variable()
+        y = opti.variable()
+        opti.minimize(sumsqr(x-2)+y**2)
+        opti.subject_to(x[0]+x[1]<=1)
+        if n>=1: opti.subject_to(y>=x[0]+0.3)
+        if n>=2: opti.subject_to(u==x[1])
+        opti.solver(nlpsolver,nlpsolver_options)
+        sol = opti.solve()
+        return sol.value(vertcat(x,y,u)) if n>=2 else sol.value(vertcat(x,y))
+
+      # Functions called in a baked expression
+      def blocks(e):
+        if e.is_output(): e = e.dep(0)
+        if e.is_call(): return [e.which_function()]
+        ret = []
+        for i in range(e.n_dep()): ret += blocks(e.dep(i))
+        return ret
+
+      # Off by default
+      opti = Opti()
+      x = opti.variable(2)
+      opti.minimize(sumsqr(x-2))
+      opti.subject_to(x[0]+x[1]<=1)
+      opti.solver(nlpsolver,nlpsolver_options)
+      opti.solve()
+      self.assertEqual(len(blocks(opti.f)+blocks(opti.g)),0)
+
+      for expand in [False, True]:
+        options = dict(nlpsolver_options)
+        options["incremental_bake"] = True
+        options["expand"] = expand
+        opti = Opti()
+        x = opti.variable(2)
+        u = opti.variable()
+        opti.minimize(sumsqr(x-2))
+        opti.subject_to(x[0]+x[1]<=1)
+        opti.solver(nlpsolver,options)
+        opti.solve()
+        [g0] = blocks(opti.g)
+        # Append a variable and a constraint
+        y = opti.variable()
+        opti.minimize(sumsqr(x-2)+y**2)
+        opti.subject_to(y>=x[0]+0.3)
+        sol = opti.solve()
+        self.checkarray(sol.value(vertcat(x,y)),reference(1),digits=7)
+        self.checkarray(sol.value(opti.g)[0],sol.value(x[0]+x[1]))
+        # The block of the first constraint is reused
+        gb = blocks(opti.g)
+        self.assertEqual(len(gb),2)
+        self.assertEqual(hash(gb[0]),hash(g0))
+        [f1] = blocks(opti.f)
+        # Append a redundant constraint: objective and earlier blocks are reused
+        opti.subject_to(y>=-10)
+        sol = opti.solve()
+        self.checkarray(sol.value(vertcat(x,y)),reference(1),digits=7)
+        self.assertEqual(hash(blocks(opti.f)[0]),hash(f1))
+        self.assertEqual(len(blocks(opti.g)),3)
+        self.assertEqual([hash(e) for e in blocks(opti.g)[:2]],[hash(e) for e in gb])
+        # Activates an earlier variable, which reorders the decision variables
+        opti.subject_to(u==x[1])
+        sol = opti.solve()
+        self.checkarray(sol.value(vertcat(x,y,u)),reference(2),digits=7)
+        self.assertEqual(opti.ng,4)
+        self.assertNotEqual(hash(blocks(opti.f)[0]),hash(f1))
+
+        # Parametric function of the blocks
+        F = opti.to_function("F",[],[vertcat(x,y,u)])
+        self.checkarray(F(),reference(2),digits=7)
+
+      # Switching the option off reverts to a flat problem
+      opti.solver(nlpsolver,nlpsolver_options)
+      sol = opti.solve()
+      self.assertEqual(len(blocks(opti.f)+blocks(opti.g)),0)
+      self.checkarray(sol.value(vertcat(x,y,u)),reference(2),digits=7)
+
 if __name__ == '__main__':
     unittest.main()
@@ -351,6 +351,24 @@ class Sparsitytests(casadiTestCase):
 
       self.checkarray(truth,tryme)
 
+  def test_nested_dissection(self):
+    # 5-point Laplacian on a 15x15 grid
+    N = 15
+    T = Sparsity.banded(N,1)
+    A = c.kron(Sparsity.diag(N),T)+c.kron(T,Sparsity.diag(N))
+    for leaf_size in [1,8,64,1000]:
+      p = A.nested_dissection(leaf_size)
+      self.checkarray(sorted(p),range(N*N))
+    p = A.nested_dissection(8)
+    Lt = A.sub(p,p)[0].ldl(False)[0]
+    Lt_nat = A.ldl(False)[0]
+    self.assertTrue(Lt.nnz()<Lt_nat.nnz())
+
+    # Disconnected blocks are ordered independently
+    B = diagcat(A,Sparsity.dense(3,3),Sparsity(2,2))
+    p = B.nested_dissection(8)
+    self.checkarray(sorted(p),range(B.size1()))
+
   def test_scc_diagcat_sparse(self):
     self.message("scc")
     random.seed(0)
@@ -1438,6 +1438,113 @@ class SXtests(casadiTestCase):
   def test_ufunc(self):
     y = np.sin(casadi.SX.sym('x'))
 
+  def test_hash_consing(self):
+    x = SX.sym("x")
+    y = SX.sym("y")
+    a = sin(x)*y
+    b = sin(x)*y
+    self.assertFalse(is_equal(a,b,0))
+
+    GlobalOptions.setHashConsing(True)
+    try:
+      a = sin(x)*y
+      b = sin(x)*y
+      c = y*sin(x)
+      self.assertTrue(is_equal(a,b,0))
+      self.assertTrue(is_equal(a,c,0))
+      self.assertFalse(is_equal(a,sin(x)/y,0))
+      self.assertFalse(is_equal(x-y,y-x,0))
+
+      # Identical subexpressions of a loop are shared
+      e = 0
+      for i in range(10):
+        e = e + cos(x*y)
+      f = Function("f",[x,y],[e])
+      self.assertEqual(f.n_nodes(),13)
+      self.checkarray(f(0.5,2),10*cos(1))
+
+      # Nodes leave the table when freed
+      del a, b, c, e, f
+      a = sin(x)*y
+      self.assertTrue(is_equal(a,sin(x)*y,0))
+    finally:
+      GlobalOptions.setHashConsing(False)
+    self.assertFalse(is_equal(a,sin(x)*y,0))
+
+  def test_tape_ad(self):
+    x = SX.sym("x",3)
+    p = SX.sym("p",Sparsity.lower(2))
+    e = [sin(x[0]*x[1])+2*x[2]**3, fmax(x[2],x[0])/p[0,0], p[1,0]*exp(x[1])]
+    f = Function("f",[x,p],[vertcat(*e),x[0]*p[1,1]+3])
+    ft = Function("f",[x,p],[vertcat(*e),x[0]*p[1,1]+3],{"tape_ad":True})
+    inputs = [DM([0.3,1.2,-0.7]),DM(Sparsity.lower(2),[1.5,0.4,2.0])]
+
+    def seeds(g):
+      return [DM(g.sparsity_in(i),np.random.rand(g.nnz_in(i))) for i in range(4,g.n_in())]
+
+    for n in [1,3]:
+      fwd = ft.forward(n)
+      self.assertEqual(fwd.class_name(),"TapeForward")
+      self.checkfunction_light(fwd,f.forward(n),inputs=inputs+[0,0]+seeds(fwd))
+      adj = ft.reverse(n)
+      self.assertEqual(adj.class_name(),"TapeReverse")
+      self.checkfunction_light(adj,f.reverse(n),inputs=inputs+[0,0]+seeds(adj))
+
+  def test_hessian_edge_pushing(self):
+    x = SX.sym("x",2,2)
+    for e in [sin(x[0,0]*x[1,1])+x[0,1]**3*exp(x[1,0]),
+              x[0,0]*x[0,0]+fmax(x[0,1],x[1,0])/cos(x[1,1])+atan2(x[0,0],x[1,0]),
+              sumsqr(x)+3*x[0,1]-log(x[1,1])*x[1,1]**x[0,0],
+              x[0,0]+2*x[1,1]]:
+      H,g = hessian(e,x)
+      H2,g2 = hessian(e,x,{"edge_pushing":True})
+      self.assertEqual(H2.shape,H.shape)
+      self.assertTrue(H2.sparsity()==H2.sparsity().T)
+      f = Function("f",[x],[densify(H),densify(g)])
+      f2 = Function("f",[x],[densify(H2),densify(g2)])
+      self.checkfunction_light(f,f2,inputs=[DM([[0.3,1.2],[0.7,0.9]])])
+
+  def test_ad_threads(self):
+    x = SX.sym("x",40)
+    y = SX.sym("y",3)
+    e = vertcat(sin(x*y[0])*x[::-1], sumsqr(x)*y[1], cos(x[:20]+x[20:])/y[2])
+    J = jacobian(e,vertcat(x,y))
+    [[fsens]] = forward([e],[x],[[DM.ones(40)]])
+    [[asens]] = reverse([e],[x],[[DM.ones(e.shape)]])
+    GlobalOptions.setMaxNumThreadsAD(4)
+    try:
+      J2 = jacobian(e,vertcat(x,y))
+      [[fsens2]] = forward([e],[x],[[DM.ones(40)]])
+      [[asens2]] = reverse([e],[x],[[DM.ones(e.shape)]])
+    finally:
+      GlobalOptions.setMaxNumThreadsAD(1)
+    f = Function("f",[x,y],[J,fsens,asens])
+    f2 = Function("f",[x,y],[J2,fsens2,asens2])
+    self.checkfunction_light(f,f2,inputs=[DM.rand(40),DM([0.3,1.2,2.5])])
+
+  def test_compact_tape(self):
+    x = SX.sym("x",30)
+    y = SX.sym("y",2)
+    e = vertcat(sin(x*y[0])*x[::-1]+3.7, sumsqr(x)*y[1], cos(x[:15]+x[15:])/y[1])
+    f = Function("f",[x,y],[e],{"compact_tape":False})
+    g = Function("g",[x,y],[e])
+    self.checkfunction_light(f,g,inputs=[DM.rand(30),DM([0.3,1.2])])
+    g2 = Function.deserialize(g.serialize())
+    self.checkfunction_light(f,g2,inputs=[DM.rand(30),DM([0.3,1.2])])
+
+    # Sparsity propagation, in both directions
+    for k in [3, e.numel()]:
+      f = Function("f",[x,y],[e[:k]],{"compact_tape":False})
+      g = Function("g",[x,y],[e[:k]])
+      for i in range(2):
+        self.assertTrue(f.sparsity_jac(i,0)==g.sparsity_jac(i,0))
+
+    # Dimensions beyond 16-bit indices fall back to the full algorithm
+    z = SX.sym("z",70000)
+    f = Function("f",[z],[sin(z)*2])
+    z0 = DM.rand(70000)
+    self.checkarray(f(z0),sin(z0)*2)
+
 
 
 if __name__ == '__main__':